@@ -26,12 +26,22 @@
 
 #include "staticlib/config.hpp"
 
+#include "staticlib/json/array_reader.hpp"
 #include "staticlib/json/array_writer.hpp"
+#include "staticlib/json/document.hpp"
+#include "staticlib/json/dump_options.hpp"
 #include "staticlib/json/field.hpp"
 #include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/key_pool.hpp"
+#include "staticlib/json/lazy_document.hpp"
+#include "staticlib/json/ndjson_reader.hpp"
 #include "staticlib/json/operations.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/push_parser.hpp"
+#include "staticlib/json/reader.hpp"
 #include "staticlib/json/type.hpp"
 #include "staticlib/json/value.hpp"
+#include "staticlib/json/writer.hpp"
 
 #endif /* STATICLIB_JSON_HPP */
 
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   array_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:20 PM
+ */
+
+#ifndef STATICLIB_JSON_ARRAY_READER_HPP
+#define STATICLIB_JSON_ARRAY_READER_HPP
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+/**
+ * Reads entries of the top-level JSON array from the underlying source
+ * one at a time, input can be produced by `json::array_writer`.
+ * No more than a single entry is kept in memory in at the same time.
+ * Input data after the closing bracket of the array is not read.
+ */
+template<typename Source>
+class array_reader {
+    parser<Source> pr;
+    bool started = false;
+    bool finished = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src input source
+     */
+    array_reader(Source&& src) :
+    pr(std::move(src)) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    array_reader(const array_reader&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    array_reader& operator=(const array_reader&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    array_reader(array_reader&& other) :
+    pr(std::move(other.pr)),
+    started(other.started),
+    finished(other.finished) { }
+
+    /**
+     * Checks whether array has more entries
+     *
+     * @return true if `next()` can be called
+     * @throws json_exception if input does not start with JSON array
+     */
+    bool has_next() {
+        if (!started) {
+            if ('[' != pr.peek()) {
+                throw pr.make_error("'[' expected");
+            }
+            pr.consume();
+            started = true;
+            if (']' == pr.peek()) {
+                pr.consume();
+                finished = true;
+            }
+        }
+        return !finished;
+    }
+
+    /**
+     * Reads next entry from the array
+     *
+     * @return entry value
+     * @throws json_exception on invalid input or if there are no more entries
+     */
+    value next() {
+        if (!has_next()) {
+            throw pr.make_error("no more entries in array");
+        }
+        value res = pr.parse();
+        int ch = pr.peek();
+        if (',' == ch) {
+            pr.consume();
+        } else if (']' == ch) {
+            pr.consume();
+            finished = true;
+        } else {
+            throw pr.make_error("']' expected");
+        }
+        return res;
+    }
+
+};
+
+/**
+ * Factory function for creating array readers,
+ * created reader will own specified source
+ *
+ * @param src input source
+ * @return reader instance
+ */
+template <typename Source,
+class = typename std::enable_if<!std::is_lvalue_reference<Source>::value>::type>
+array_reader<Source> make_array_reader(Source&& src) {
+    return array_reader<Source>(std::move(src));
+}
+
+/**
+ * Factory function for creating array readers,
+ * created reader will NOT own specified source
+ *
+ * @param src input source
+ * @return reader instance
+ */
+template <typename Source>
+array_reader<sl::io::reference_source<Source>> make_array_reader(Source& src) {
+    return array_reader<sl::io::reference_source<Source>> (sl::io::make_reference_source(src));
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_ARRAY_READER_HPP */
+
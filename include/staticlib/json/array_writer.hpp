@@ -27,7 +27,9 @@
 #include "staticlib/config.hpp"
 #include "staticlib/io.hpp"
 
+#include "staticlib/json/dump_options.hpp"
 #include "staticlib/json/value.hpp"
+#include "staticlib/json/writer.hpp"
 
 namespace staticlib {
 namespace json {
@@ -35,22 +37,45 @@ namespace json {
 /**
  * Writes entries to the underlying sink formatting the output as
  * JSON array. No more than a single entry is kept in memory in at the same time.
- * Entries are dumped directly to underlying sink without intermediate string representation.
+ * Entries are dumped directly to underlying sink without intermediate string representation,
+ * output is buffered, buffer is written to the sink when it is full, on `flush()`
+ * and on destruction.
  */
 template<typename Sink>
 class array_writer {
     Sink sink;
+    sl::io::unbuffered_ostreambuf<sl::io::reference_sink<Sink>> sbuf;
+    detail_writer::output out;
+    dump_options options;
     bool first_entry_written = false;
     
 public:
-    array_writer(Sink&& sink) :
-    sink(std::move(sink)) {
-        sl::io::write_all(this->sink, {"[\n"});
+    /**
+     * Constructor, writes array opening bracket
+     * 
+     * @param sink destination sink
+     * @param options serialization options for entries and separators
+     */
+    array_writer(Sink&& sink, const dump_options& options = dump_options()) :
+    sink(std::move(sink)),
+    sbuf(sl::io::make_unbuffered_ostreambuf(this->sink)),
+    out(std::addressof(sbuf)),
+    options(options) {
+        if (pretty()) {
+            out.write("[\n", 2);
+        } else {
+            out.put('[');
+        }
     }
     
     ~array_writer() STATICLIB_NOEXCEPT {
         try {
-            sl::io::write_all(sink, {"\n]\n"});
+            if (pretty()) {
+                out.write("\n]\n", 3);
+            } else {
+                out.put(']');
+            }
+            out.flush();
         } catch (...) {
             // keep silent
         }
@@ -78,6 +103,9 @@ public:
      */
     array_writer(array_writer&& other) :
     sink(std::move(other.sink)),
+    sbuf(sl::io::make_unbuffered_ostreambuf(this->sink)),
+    out(std::move(other.out), std::addressof(sbuf)),
+    options(other.options),
     first_entry_written(other.first_entry_written) { }
     
     /**
@@ -87,7 +115,10 @@ public:
      * @returns this instance
      */
     array_writer& operator=(array_writer&& other) {
+        out.flush();
         sink = std::move(other.sink);
+        out = std::move(other.out);
+        options = other.options;
         first_entry_written = other.first_entry_written;
         return *this;
     }
@@ -99,11 +130,28 @@ public:
      */
     void write(const value& entry) {
         if (first_entry_written) {
-            sl::io::write_all(sink, {",\n"});
+            out.put(',');
+            if (pretty()) {
+                out.put('\n');
+            } else if (!options.compact) {
+                out.put(' ');
+            }
         } else {
             first_entry_written = true;
         }
-        entry.dump(sink);
+        detail_writer::dump_value(out, entry, options, 0);
+    }
+
+    /**
+     * Writes buffered output to the sink
+     */
+    void flush() {
+        out.flush();
+    }
+
+private:
+    bool pretty() const {
+        return !options.compact && options.indent > 0;
     }
     
 };
@@ -113,12 +161,13 @@ public:
  * created writer will own specified sink
  * 
  * @param sink destination sink
+ * @param options serialization options
  * @return writer instance
  */
 template <typename Sink,
 class = typename std::enable_if<!std::is_lvalue_reference<Sink>::value>::type>
-array_writer<Sink> make_array_writer(Sink&& sink) {
-    return array_writer<Sink>(std::move(sink));
+array_writer<Sink> make_array_writer(Sink&& sink, const dump_options& options = dump_options()) {
+    return array_writer<Sink>(std::move(sink), options);
 }
 
 /**
@@ -126,11 +175,12 @@ array_writer<Sink> make_array_writer(Sink&& sink) {
  * created writer will NOT own specified sink
  * 
  * @param sink destination sink
+ * @param options serialization options
  * @return writer instance
  */
 template <typename Sink>
-array_writer<sl::io::reference_sink<Sink>> make_array_writer(Sink& sink) {
-    return array_writer<sl::io::reference_sink<Sink>> (sl::io::make_reference_sink(sink));
+array_writer<sl::io::reference_sink<Sink>> make_array_writer(Sink& sink, const dump_options& options = dump_options()) {
+    return array_writer<sl::io::reference_sink<Sink>> (sl::io::make_reference_sink(sink), options);
 }
 
 } // namespace
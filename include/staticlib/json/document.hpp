@@ -0,0 +1,507 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   document.hpp
+ * Author: alex
+ *
+ * Created on October 20, 2026, 3:20 PM
+ */
+
+#ifndef STATICLIB_JSON_DOCUMENT_HPP
+#define STATICLIB_JSON_DOCUMENT_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/type.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_document {
+
+/**
+ * Tag of the tape word, stored in its upper byte
+ */
+enum class tag : uint8_t {
+    // payload: number of entries (upper 24 bits) and the index of the word after the container
+    object = 1,
+    array,
+    // payload: offset of the length-prefixed data in strings buffer
+    key,
+    string,
+    // followed by a word with the number bits
+    integer,
+    real,
+    // payload: 0 or 1
+    boolean,
+    nullt
+};
+
+/**
+ * Parser events handler that writes the tape
+ */
+class builder {
+    class open_container {
+    public:
+        size_t idx;
+        size_t count;
+        bool object;
+    };
+
+    std::vector<open_container> stack;
+
+public:
+    std::vector<uint64_t> tape;
+    std::string strings;
+
+    builder() { }
+
+    builder(const builder&) = delete;
+
+    builder& operator=(const builder&) = delete;
+
+    builder(builder&& other) :
+    stack(std::move(other.stack)),
+    tape(std::move(other.tape)),
+    strings(std::move(other.strings)) { }
+
+    void start_object();
+
+    void key(const std::string& name);
+
+    void end_object();
+
+    void start_array();
+
+    void end_array();
+
+    void string(const std::string& val);
+
+    void integer(int64_t val);
+
+    void real(double val);
+
+    void boolean(bool val);
+
+    void null();
+
+private:
+    void start_container(tag tg);
+
+    void end_container(tag tg);
+
+    void add_entry();
+
+    void add_string(tag tg, const std::string& str);
+};
+
+} // namespace
+
+// forward declaration
+class document;
+class document_field;
+
+/**
+ * Lightweight view of the single JSON element inside the `document`.
+ * Missing attributes are returned as `null` views, same as with `json::value`.
+ * Can be copied freely, is valid only while the document it was
+ * obtained from is alive and is not moved.
+ */
+class document_value {
+    friend class document;
+    friend class document_field;
+
+    const document* doc;
+    size_t idx;
+
+public:
+    /**
+     * Iterator over the elements of array
+     */
+    class array_iterator {
+        const document* doc;
+        size_t idx;
+
+    public:
+        array_iterator(const document* doc, size_t idx) :
+        doc(doc),
+        idx(idx) { }
+
+        document_value operator*() const {
+            return document_value(doc, idx);
+        }
+
+        array_iterator& operator++();
+
+        bool operator==(const array_iterator& other) const {
+            return idx == other.idx;
+        }
+
+        bool operator!=(const array_iterator& other) const {
+            return idx != other.idx;
+        }
+    };
+
+    /**
+     * Iterator over the fields of object
+     */
+    class object_iterator {
+        const document* doc;
+        size_t idx;
+
+    public:
+        object_iterator(const document* doc, size_t idx) :
+        doc(doc),
+        idx(idx) { }
+
+        document_field operator*() const;
+
+        object_iterator& operator++();
+
+        bool operator==(const object_iterator& other) const {
+            return idx == other.idx;
+        }
+
+        bool operator!=(const object_iterator& other) const {
+            return idx != other.idx;
+        }
+    };
+
+    /**
+     * Range of entries to be used in range-based `for` loop
+     */
+    template<typename Iterator>
+    class range {
+        Iterator first;
+        Iterator last;
+
+    public:
+        range(Iterator first, Iterator last) :
+        first(first),
+        last(last) { }
+
+        Iterator begin() const {
+            return first;
+        }
+
+        Iterator end() const {
+            return last;
+        }
+    };
+
+    /**
+     * Constructs `null` view
+     */
+    document_value();
+
+    /**
+     * Type of this element
+     *
+     * @return type of this element
+     */
+    type json_type() const;
+
+    /**
+     * Finds an attribute of this object by its name
+     *
+     * @param name attribute name
+     * @return attribute view, or `null` view if this element is
+     *         not an object or attribute is not found
+     */
+    document_value getattr(const std::string& name) const;
+
+    /**
+     * Finds an attribute of this object by its name,
+     * same as `getattr`
+     *
+     * @param name attribute name
+     * @return attribute view, or `null` view if this element is
+     *         not an object or attribute is not found
+     */
+    document_value operator[](const std::string& name) const;
+
+    /**
+     * Finds an element of this array by its index
+     *
+     * @param idx element index
+     * @return element view, or `null` view if this element is
+     *         not an array or index is out of range
+     */
+    document_value at(size_t idx) const;
+
+    /**
+     * Number of fields in object or number of elements in array
+     *
+     * @return number of entries, `0` for non-container elements
+     */
+    size_t size() const;
+
+    /**
+     * Access this element as an `OBJECT`
+     *
+     * @return range of fields, empty range if this element is not an object
+     */
+    range<object_iterator> as_object() const;
+
+    /**
+     * Access this element as an `ARRAY`
+     *
+     * @return range of elements, empty range if this element is not an array
+     */
+    range<array_iterator> as_array() const;
+
+    /**
+     * Access this element as a `STRING` without copying
+     *
+     * @return string data, empty span if this element is not a string
+     */
+    sl::io::span<const char> as_string_span() const;
+
+    /**
+     * Access this element as a `STRING`
+     *
+     * @return copy of string value, empty string if this element is not a string
+     */
+    std::string as_string() const;
+
+    /**
+     * Access this element as a `STRING`
+     *
+     * @param context optional context to be included in exception message
+     * @return copy of string value
+     * @throws json_exception if this element is not a string
+     */
+    std::string as_string_or_throw(const std::string& context = "") const;
+
+    /**
+     * Access this element as an `INTEGER`
+     *
+     * @return integer value, `0` if this element is not an integer
+     */
+    int64_t as_int64() const;
+
+    /**
+     * Access this element as an `INTEGER`
+     *
+     * @param context optional context to be included in exception message
+     * @return integer value
+     * @throws json_exception if this element is not an integer
+     */
+    int64_t as_int64_or_throw(const std::string& context = "") const;
+
+    /**
+     * Access this element as a `REAL`
+     *
+     * @return real value, `0` if this element is not a real number
+     */
+    double as_double() const;
+
+    /**
+     * Access this element as a `REAL`
+     *
+     * @param context optional context to be included in exception message
+     * @return real value
+     * @throws json_exception if this element is not a real number
+     */
+    double as_double_or_throw(const std::string& context = "") const;
+
+    /**
+     * Access this element as a `BOOLEAN`
+     *
+     * @return boolean value, `false` if this element is not a boolean
+     */
+    bool as_bool() const;
+
+    /**
+     * Access this element as a `BOOLEAN`
+     *
+     * @param context optional context to be included in exception message
+     * @return boolean value
+     * @throws json_exception if this element is not a boolean
+     */
+    bool as_bool_or_throw(const std::string& context = "") const;
+
+    /**
+     * Copies this element (including all nested elements)
+     * into `json::value` instance
+     *
+     * @return value
+     */
+    value to_value() const;
+
+private:
+    document_value(const document* doc, size_t idx);
+
+    json_exception access_error(const std::string& target, const std::string& context) const;
+};
+
+/**
+ * View of the single field of the object inside the `document`
+ */
+class document_field {
+    const document* doc;
+    size_t idx;
+
+public:
+    /**
+     * Constructor for internal use
+     *
+     * @param doc document
+     * @param idx tape index of the field name
+     */
+    document_field(const document* doc, size_t idx) :
+    doc(doc),
+    idx(idx) { }
+
+    /**
+     * Field name accessor
+     *
+     * @return copy of field name
+     */
+    std::string name() const;
+
+    /**
+     * Field name accessor
+     *
+     * @return field name data
+     */
+    sl::io::span<const char> name_span() const;
+
+    /**
+     * Field value accessor
+     *
+     * @return field value view
+     */
+    document_value val() const;
+};
+
+/**
+ * Immutable JSON document stored as a flat tape: a single array of tagged
+ * 64-bit words (one or two words per element) with string data in a separate
+ * buffer. Containers know their size and the position of the next element,
+ * so the tape is traversed without pointer chasing and element views are
+ * created without allocations.
+ *
+ * Reads only the first JSON element from input ignoring the data that follows it.
+ * Duplicate keys in objects are NOT checked, `getattr` returns the first field.
+ * Input data is not referenced after the document is created.
+ */
+class document {
+    friend class document_value;
+    friend class document_field;
+
+    std::vector<uint64_t> tape;
+    std::string strings;
+
+public:
+    /**
+     * Constructor, parses specified input
+     *
+     * @param data input data
+     * @throws json_exception on invalid input
+     */
+    document(sl::io::span<const char> data);
+
+    /**
+     * Constructor for internal use
+     *
+     * @param bld builder with a finished tape
+     */
+    document(detail_document::builder&& bld);
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    document(const document&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    document& operator=(const document&) = delete;
+
+    /**
+     * Move constructor, views obtained from other
+     * document become invalid
+     *
+     * @param other other instance
+     */
+    document(document&& other);
+
+    /**
+     * Accessor for the top-level element
+     *
+     * @return top-level element view
+     */
+    document_value root() const;
+
+    /**
+     * Finds an attribute of the top-level object by its name
+     *
+     * @param name attribute name
+     * @return attribute view, or `null` view if not found
+     */
+    document_value operator[](const std::string& name) const;
+
+    /**
+     * Returns the number of words in tape
+     *
+     * @return tape size
+     */
+    size_t tape_size() const {
+        return tape.size();
+    }
+
+private:
+    size_t next_index(size_t idx) const;
+
+    sl::io::span<const char> string_at(size_t idx) const;
+
+};
+
+/**
+ * Factory function for creating documents from arbitrary sources
+ *
+ * @param src input source
+ * @return document
+ * @throws json_exception on invalid input
+ */
+template <typename Source>
+document make_document(Source& src) {
+    auto pr = make_parser(src);
+    auto bld = detail_document::builder();
+    pr.parse(bld);
+    return document(std::move(bld));
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_DOCUMENT_HPP */
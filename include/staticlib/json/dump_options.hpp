@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dump_options.hpp
+ * Author: alex
+ *
+ * Created on October 21, 2026, 10:05 AM
+ */
+
+#ifndef STATICLIB_JSON_DUMP_OPTIONS_HPP
+#define STATICLIB_JSON_DUMP_OPTIONS_HPP
+
+#include <cstddef>
+
+namespace staticlib {
+namespace json {
+
+/**
+ * Options of JSON serialization, default options produce the same output
+ * as before: pretty-printed with 4 spaces, fields in insertion order,
+ * shortest round-trip reals and UTF-8 strings
+ */
+class dump_options {
+public:
+    /**
+     * Compact output without any whitespace, `indent` is ignored
+     */
+    bool compact = false;
+
+    /**
+     * Number of spaces used for each nesting level, with `0` the output
+     * is written on a single line with a space after separators
+     */
+    size_t indent = 4;
+
+    /**
+     * Write object fields ordered by name (byte-wise) instead of insertion order
+     */
+    bool sort_keys = false;
+
+    /**
+     * Number of significant digits written for real values, `0` means the
+     * shortest digits that are read back into the same value,
+     * values greater than `17` are treated as `17`
+     */
+    size_t real_precision = 0;
+
+    /**
+     * Escape all non-ASCII characters in strings as `\uXXXX`
+     * (with surrogate pairs for characters outside of BMP)
+     */
+    bool ensure_ascii = false;
+
+    /**
+     * Constructor, creates default options
+     */
+    dump_options() { }
+
+    /**
+     * Factory function for compact options
+     *
+     * @return options for compact output
+     */
+    static dump_options compact_output() {
+        auto res = dump_options();
+        res.compact = true;
+        return res;
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_DUMP_OPTIONS_HPP */
@@ -35,16 +35,42 @@
 namespace staticlib {
 namespace json {
 
+// forward declaration
+class key_pool;
+
+namespace detail_key_pool {
+
+// forward declaration
+class key_node;
+
+} // namespace
+
 /**
  * Representation of the reflected object field. Implemented as `name, value` tuple.
  * This class mimics `value` methods like `as_array` to access field value directly 
  * from this object without intermediate `value()` call.
+ * 
+ * Name is stored in the field itself. Fields created with `key_pool` instead keep
+ * a pointer to the immutable reference-counted name, that is shared by all fields
+ * with the same name created with this pool and by the clones of these fields.
  */
 class field {
-    std::string field_name;
+    friend class key_pool;
+    // std::string is placed into the storage with placement new,
+    // unrestricted unions are not supported in msvc 2013
+    union {
+        char owned_name[sizeof(std::string)];
+        detail_key_pool::key_node* interned_name;
+    };
+    bool name_interned = false;
     value field_value;
 
 public:
+    /**
+     * Destructor
+     */
+    ~field() STATICLIB_NOEXCEPT;
+
     /**
      * Deleted copy constructor
      * 
@@ -101,6 +127,13 @@ public:
      */
     const std::string& name() const;
 
+    /**
+     * Checks whether the name of this field is interned with `key_pool`
+     * 
+     * @return `true` if name is interned
+     */
+    bool is_name_interned() const;
+
     /**
      * Returns type of the value in this field
      * 
@@ -136,6 +169,14 @@ public:
      */
     field clone() const;
 
+    /**
+     * Copy method that shares `OBJECT` and `ARRAY` nodes of the field value
+     * (see `value::clone_shared`)
+     * 
+     * @return copy of current instance
+     */
+    field clone_shared() const;
+
     /**
      * Access value as an `OBJECT`
      * 
@@ -481,6 +522,15 @@ public:
      */
     bool as_bool(bool default_val) const;
 
+private:
+    field(detail_key_pool::key_node* name_node, value json_value);
+
+    std::string& owned_name_str();
+
+    void release_name() STATICLIB_NOEXCEPT;
+
+    void move_name(field& other) STATICLIB_NOEXCEPT;
+
 };
 
 } // namespace
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   key_pool.hpp
+ * Author: alex
+ *
+ * Created on October 20, 2026, 11:05 AM
+ */
+
+#ifndef STATICLIB_JSON_KEY_POOL_HPP
+#define STATICLIB_JSON_KEY_POOL_HPP
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "staticlib/config.hpp"
+
+#include "staticlib/json/field.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_key_pool {
+
+/**
+ * Immutable field name interned with 'key_pool' and shared between fields,
+ * released when the last reference to it is dropped
+ */
+class key_node {
+    std::atomic<size_t> refs;
+
+public:
+    const std::string str;
+
+    key_node(std::string str) :
+    refs(1),
+    str(std::move(str)) { }
+
+    key_node(const key_node&) = delete;
+
+    key_node& operator=(const key_node&) = delete;
+
+    void add_ref() {
+        refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() {
+        if (1 == refs.fetch_sub(1, std::memory_order_acq_rel)) {
+            delete this;
+        }
+    }
+};
+
+class key_hash {
+public:
+    size_t operator()(const std::string* key) const {
+        return std::hash<std::string>()(*key);
+    }
+};
+
+class key_equal {
+public:
+    bool operator()(const std::string* left, const std::string* right) const {
+        return *left == *right;
+    }
+};
+
+} // namespace
+
+/**
+ * Table of the interned object field names. Fields created with
+ * this pool share one immutable copy of the name for each distinct name,
+ * that is useful for the large arrays of records that have the same keys.
+ *
+ * Shared names are reference-counted and remain valid after the
+ * pool is destroyed. Pool is not thread-safe, fields created with it
+ * can be used from any thread.
+ */
+class key_pool {
+    std::unordered_map<const std::string*, detail_key_pool::key_node*,
+            detail_key_pool::key_hash, detail_key_pool::key_equal> keys;
+
+public:
+    /**
+     * Constructor
+     */
+    key_pool() { }
+
+    /**
+     * Destructor, releases the names that are not used by any fields
+     */
+    ~key_pool() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    key_pool(const key_pool&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    key_pool& operator=(const key_pool&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    key_pool(key_pool&& other);
+
+    /**
+     * Returns interned copy of the specified name, reference is valid
+     * while this pool is alive. Lookups in objects (`value::getattr`) with
+     * the interned names find fields created with this pool by a pointer
+     * comparison.
+     *
+     * @param name field name
+     * @return interned name
+     */
+    const std::string& intern(const std::string& name);
+
+    /**
+     * Creates a field with interned name
+     *
+     * @param name field name
+     * @param json_value field value
+     * @return field instance
+     */
+    field make_field(const std::string& name, value json_value);
+
+    /**
+     * Returns the number of distinct names in this pool
+     *
+     * @return number of names
+     */
+    size_t size() const {
+        return keys.size();
+    }
+
+private:
+    detail_key_pool::key_node* find_or_add(const std::string& name);
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_KEY_POOL_HPP */
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   lazy_document.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 10:05 AM
+ */
+
+#ifndef STATICLIB_JSON_LAZY_DOCUMENT_HPP
+#define STATICLIB_JSON_LAZY_DOCUMENT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/type.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_lazy {
+
+/**
+ * Position of the object or array in input data
+ */
+class extent {
+public:
+    // offset of the byte after the closing bracket
+    size_t end;
+    // ordinal number of the first container after this one
+    size_t next;
+};
+
+} // namespace
+
+// forward declaration
+class lazy_document;
+
+/**
+ * Lightweight view of the single JSON element inside the `lazy_document`.
+ * Input data of the element is decoded only on access, accessed strings
+ * and numbers are decoded on every call and are not cached.
+ * Missing attributes are returned as `null` views, same as with `json::value`.
+ * Can be copied freely, is valid only while the document it was
+ * obtained from is alive and is not moved.
+ */
+class lazy_value {
+    const lazy_document* doc;
+    size_t offset;
+    size_t ordinal;
+
+public:
+    /**
+     * Constructs `null` view
+     */
+    lazy_value();
+
+    /**
+     * Constructor for internal use
+     *
+     * @param doc document
+     * @param offset offset of the element in input data
+     * @param ordinal ordinal number of the first container at or after the offset
+     */
+    lazy_value(const lazy_document* doc, size_t offset, size_t ordinal);
+
+    /**
+     * Type of this element, determined by the first byte of its input data
+     *
+     * @return type of this element
+     * @throws json_exception on invalid token
+     */
+    type json_type() const;
+
+    /**
+     * Finds an attribute of this object by its name, fields
+     * that precede this attribute are skipped without decoding
+     *
+     * @param name attribute name
+     * @return attribute view, or `null` view if this element is
+     *         not an object or attribute is not found
+     * @throws json_exception on invalid input
+     */
+    lazy_value getattr(const std::string& name) const;
+
+    /**
+     * Finds an attribute of this object by its name,
+     * same as `getattr`
+     *
+     * @param name attribute name
+     * @return attribute view, or `null` view if this element is
+     *         not an object or attribute is not found
+     * @throws json_exception on invalid input
+     */
+    lazy_value operator[](const std::string& name) const;
+
+    /**
+     * Finds an element of this array by its index
+     *
+     * @param idx element index
+     * @return element view, or `null` view if this element is
+     *         not an array or index is out of range
+     * @throws json_exception on invalid input
+     */
+    lazy_value at(size_t idx) const;
+
+    /**
+     * Number of fields in object or number of elements in array
+     *
+     * @return number of entries, `0` for non-container elements
+     * @throws json_exception on invalid input
+     */
+    size_t size() const;
+
+    /**
+     * Names of the fields of this object in input order
+     *
+     * @return list of field names, empty list if this element is not an object
+     * @throws json_exception on invalid input
+     */
+    std::vector<std::string> keys() const;
+
+    /**
+     * Decodes this element as a string
+     *
+     * @return string value, empty string if this element is not a string
+     * @throws json_exception on invalid input
+     */
+    std::string as_string() const;
+
+    /**
+     * Decodes this element as a string
+     *
+     * @param context optional context to be included in exception message
+     * @return string value
+     * @throws json_exception if this element is not a string
+     */
+    std::string as_string_or_throw(const std::string& context = "") const;
+
+    /**
+     * Decodes this element as an integer
+     *
+     * @return integer value, `0` if this element is not an integer
+     * @throws json_exception on invalid input
+     */
+    int64_t as_int64() const;
+
+    /**
+     * Decodes this element as an integer
+     *
+     * @param context optional context to be included in exception message
+     * @return integer value
+     * @throws json_exception if this element is not an integer
+     */
+    int64_t as_int64_or_throw(const std::string& context = "") const;
+
+    /**
+     * Decodes this element as a real number
+     *
+     * @return real value, `0` if this element is not a real number
+     * @throws json_exception on invalid input
+     */
+    double as_double() const;
+
+    /**
+     * Decodes this element as a real number
+     *
+     * @param context optional context to be included in exception message
+     * @return real value
+     * @throws json_exception if this element is not a real number
+     */
+    double as_double_or_throw(const std::string& context = "") const;
+
+    /**
+     * Decodes this element as a boolean
+     *
+     * @return boolean value, `false` if this element is not a boolean
+     * @throws json_exception on invalid input
+     */
+    bool as_bool() const;
+
+    /**
+     * Decodes this element as a boolean
+     *
+     * @param context optional context to be included in exception message
+     * @return boolean value
+     * @throws json_exception if this element is not a boolean
+     */
+    bool as_bool_or_throw(const std::string& context = "") const;
+
+    /**
+     * Fully decodes this element (including all nested elements)
+     * into `json::value` instance
+     *
+     * @return decoded value
+     * @throws json_exception on invalid input
+     */
+    value to_value() const;
+
+private:
+    sl::io::span<const char> tail() const;
+
+    json_exception access_error(const std::string& target, const std::string& context) const;
+};
+
+/**
+ * Lazy JSON document over the input data that is NOT owned by the document.
+ * On creation the input is scanned once to find the extents of all objects
+ * and arrays - strings and numbers are not decoded at this point.
+ * Then contents of the document can be accessed through `lazy_value` views,
+ * only the accessed scalar values are decoded and checked,
+ * the rest of input data is skipped without decoding.
+ *
+ * Input data must not be changed and must outlive the document.
+ * Reads only the first JSON element from input ignoring the data that follows it.
+ */
+class lazy_document {
+    friend class lazy_value;
+
+    sl::io::span<const char> data;
+    std::vector<detail_lazy::extent> extents;
+    size_t root_offset = 0;
+
+public:
+    /**
+     * Constructor, scans input data
+     *
+     * @param data input data, must outlive this document
+     * @throws json_exception on unbalanced brackets or unterminated strings
+     */
+    lazy_document(sl::io::span<const char> data);
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    lazy_document(const lazy_document&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    lazy_document& operator=(const lazy_document&) = delete;
+
+    /**
+     * Move constructor, views obtained from other
+     * document become invalid
+     *
+     * @param other other instance
+     */
+    lazy_document(lazy_document&& other);
+
+    /**
+     * Accessor for the top-level element
+     *
+     * @return top-level element view
+     */
+    lazy_value root() const;
+
+    /**
+     * Finds an attribute of the top-level object by its name
+     *
+     * @param name attribute name
+     * @return attribute view, or `null` view if not found
+     * @throws json_exception on invalid input
+     */
+    lazy_value operator[](const std::string& name) const;
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_LAZY_DOCUMENT_HPP */
+
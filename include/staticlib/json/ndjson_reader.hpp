@@ -0,0 +1,147 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   ndjson_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:12 PM
+ */
+
+#ifndef STATICLIB_JSON_NDJSON_READER_HPP
+#define STATICLIB_JSON_NDJSON_READER_HPP
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+/**
+ * Reads newline-delimited JSON (NDJSON, JSON Lines) from the underlying source
+ * one record at a time. Input is read through the fixed-size buffer, only
+ * the current record is kept in memory.
+ * Each record must be a single JSON value (not necessary an object),
+ * records must be separated with line feeds, empty lines are skipped.
+ */
+template<typename Source>
+class ndjson_reader {
+    parser<Source> pr;
+    size_t count = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src input source
+     */
+    ndjson_reader(Source&& src) :
+    pr(std::move(src)) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    ndjson_reader(const ndjson_reader&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    ndjson_reader& operator=(const ndjson_reader&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    ndjson_reader(ndjson_reader&& other) :
+    pr(std::move(other.pr)),
+    count(other.count) { }
+
+    /**
+     * Checks whether input contains more records
+     *
+     * @return true if `next()` can be called
+     */
+    bool has_next() {
+        return -1 != pr.peek();
+    }
+
+    /**
+     * Reads next record from input
+     *
+     * @return record value
+     * @throws json_exception on invalid input or if there are no more records
+     */
+    value next() {
+        value res = pr.parse();
+        int ch = pr.peek_line();
+        if ('\n' != ch && -1 != ch) {
+            throw pr.make_error("line feed expected after the record");
+        }
+        count += 1;
+        return res;
+    }
+
+    /**
+     * Number of records read
+     *
+     * @return number of records
+     */
+    size_t records_count() const {
+        return count;
+    }
+
+};
+
+/**
+ * Factory function for creating NDJSON readers,
+ * created reader will own specified source
+ *
+ * @param src input source
+ * @return reader instance
+ */
+template <typename Source,
+class = typename std::enable_if<!std::is_lvalue_reference<Source>::value>::type>
+ndjson_reader<Source> make_ndjson_reader(Source&& src) {
+    return ndjson_reader<Source>(std::move(src));
+}
+
+/**
+ * Factory function for creating NDJSON readers,
+ * created reader will NOT own specified source
+ *
+ * @param src input source
+ * @return reader instance
+ */
+template <typename Source>
+ndjson_reader<sl::io::reference_source<Source>> make_ndjson_reader(Source& src) {
+    return ndjson_reader<sl::io::reference_source<Source>> (sl::io::make_reference_source(src));
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_NDJSON_READER_HPP */
+
@@ -24,12 +24,15 @@
 #ifndef STATICLIB_JSON_OPERATIONS_HPP
 #define STATICLIB_JSON_OPERATIONS_HPP
 
+#include <memory>
 #include <streambuf>
 #include <string>
 
 #include "staticlib/io.hpp"
 
 #include "staticlib/json/field.hpp"
+#include "staticlib/json/key_pool.hpp"
+#include "staticlib/json/parser.hpp"
 #include "staticlib/json/value.hpp"
 #include "staticlib/json/json_exception.hpp"
 
@@ -60,8 +63,8 @@ value load(std::streambuf* src);
  */
 template <typename Source>
 value load(Source& src) {
-    auto sbuf = sl::io::make_unbuffered_istreambuf(src);
-    return load(std::addressof(sbuf));
+    auto pr = make_parser(src);
+    return pr.parse();
 }
 
 /**
@@ -75,23 +78,168 @@ value load(Source& src) {
  * @throws json_exception      
  */
 inline value load(sl::io::span<const char> span) {
-    auto src = sl::io::array_source(span);
-    return load(src);
+    auto pr = parser<sl::io::span<const char>>(std::move(span));
+    return pr.parse();
 }
 
 /**
- * Deserializes data from specified source into 'json::value'.
+ * Deserializes data from specified mutable buffer into 'json::value'
+ * decoding string values in place: unescaped strings are written
+ * back into the buffer and string values reference it
+ * (see 'value::borrowed_string'). Buffer must outlive the returned value,
+ * its contents are unspecified after parsing (including failed parsing).
+ * Object field names are copied.
  * Supports 'bare' (non-object, non-array) JSON input.
  * Supports partial input: will read only first valid JSON element 
  * from input source.
  * 
- * @param span source span with JSON
+ * @param span source span with JSON, is modified during parsing
  * @return instance of 'json::value'
  * @throws json_exception      
  */
 inline value load(sl::io::span<char> span) {
-    auto src = sl::io::array_source(span);
-    return load(src);
+    auto pr = parser<sl::io::span<const char>>(sl::io::span<const char>(span.data(), span.size()));
+    pr.set_unescape_in_place(true);
+    return pr.parse();
+}
+
+/**
+ * Deserializes data from specified source into 'json::value'
+ * without copying string values that need no unescaping, such
+ * strings reference the input data (see 'value::borrowed_string').
+ * Input data must not be changed and must outlive the returned value.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input source.
+ *
+ * @param span source span with JSON
+ * @return instance of 'json::value'
+ * @throws json_exception
+ */
+inline value load_borrowed(sl::io::span<const char> span) {
+    auto pr = parser<sl::io::span<const char>>(std::move(span));
+    pr.set_borrow_strings(true);
+    return pr.parse();
+}
+
+/**
+ * Deserializes data from specified source into 'json::value' packing
+ * non-empty arrays that contain only integers or only real numbers
+ * (see 'value::packed_int64_array'), elements of such arrays are stored
+ * contiguously and can be accessed with 'value::as_int64_span'
+ * and 'value::as_double_span'. Access to packed array through const
+ * 'value::as_array' keeps expanded values along with the packed numbers,
+ * doubling the memory used by the array.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input source.
+ *
+ * @param span source span with JSON
+ * @return instance of 'json::value'
+ * @throws json_exception
+ */
+inline value load_packed(sl::io::span<const char> span) {
+    auto pr = parser<sl::io::span<const char>>(std::move(span));
+    pr.set_pack_numeric_arrays(true);
+    return pr.parse();
+}
+
+/**
+ * Deserializes data from specified source into 'json::value' interning
+ * object field names with the specified pool, fields with the same name
+ * share the single copy of it.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input source.
+ *
+ * @param span source span with JSON
+ * @param pool names pool
+ * @return instance of 'json::value'
+ * @throws json_exception
+ */
+inline value load(sl::io::span<const char> span, key_pool& pool) {
+    auto pr = parser<sl::io::span<const char>>(std::move(span));
+    pr.set_key_pool(std::addressof(pool));
+    return pr.parse();
+}
+
+/**
+ * Parses JSON from specified streambuf reporting its contents to
+ * the specified handler as a sequence of events (SAX-style),
+ * no 'json::value' instances are created.
+ * See 'json::parser::parse(Handler&)' for the list of handler methods.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input source.
+ * Duplicate keys in objects are NOT checked.
+ *
+ * @param src streambuf with JSON
+ * @param handler events handler
+ * @throws json_exception
+ */
+template <typename Handler>
+void load(std::streambuf* src, Handler& handler) {
+    auto pr = parser<sl::io::streambuf_source>(sl::io::streambuf_source(src));
+    pr.parse(handler);
+}
+
+/**
+ * Parses JSON from specified source reporting its contents to
+ * the specified handler as a sequence of events (SAX-style),
+ * no 'json::value' instances are created.
+ * See 'json::parser::parse(Handler&)' for the list of handler methods.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input source.
+ * Duplicate keys in objects are NOT checked.
+ *
+ * @param src source with JSON
+ * @param handler events handler
+ * @throws json_exception
+ */
+template <typename Source, typename Handler>
+void load(Source& src, Handler& handler) {
+    auto pr = make_parser(src);
+    pr.parse(handler);
+}
+
+/**
+ * Parses JSON from specified span reporting its contents to
+ * the specified handler as a sequence of events (SAX-style),
+ * no 'json::value' instances are created.
+ * See 'json::parser::parse(Handler&)' for the list of handler methods.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input source.
+ * Duplicate keys in objects are NOT checked.
+ *
+ * @param span source span with JSON
+ * @param handler events handler
+ * @throws json_exception
+ */
+template <typename Handler>
+void load(sl::io::span<const char> span, Handler& handler) {
+    auto pr = parser<sl::io::span<const char>>(std::move(span));
+    pr.parse(handler);
+}
+
+/**
+ * Parses specified JSON string reporting its contents to
+ * the specified handler as a sequence of events (SAX-style),
+ * no 'json::value' instances are created.
+ * See 'json::parser::parse(Handler&)' for the list of handler methods.
+ * Supports 'bare' (non-object, non-array) JSON input.
+ * Supports partial input: will read only first valid JSON element
+ * from input string.
+ * Duplicate keys in objects are NOT checked.
+ *
+ * @param str JSON string
+ * @param handler events handler
+ * @throws json_exception
+ */
+template <typename Handler>
+void loads(const std::string& str, Handler& handler) {
+    load(sl::io::span<const char>(str.data(), str.length()), handler);
 }
 
 /**
@@ -111,9 +259,10 @@ value loads(const std::string& str);
  * literal and dump it to string
  * 
  * @param json json, possible literal
+ * @param options serialization options
  * @return string representation
  */
-std::string dumps(const value& json);
+std::string dumps(const value& json, const dump_options& options = dump_options());
 
 /**
  * Reference to null json value
@@ -0,0 +1,1471 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   parser.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 10:12 AM
+ */
+
+#ifndef STATICLIB_JSON_PARSER_HPP
+#define STATICLIB_JSON_PARSER_HPP
+
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/json/field.hpp"
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/key_pool.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_parser {
+
+/**
+ * Max nesting level of objects and arrays, same as in Jansson
+ */
+const size_t max_depth = 2048;
+
+/**
+ * Size of the read buffer used with streaming sources
+ */
+const size_t buffer_size = 4096;
+
+/**
+ * Objects with more fields than this are checked for duplicate
+ * keys using hash set instead of the linear scan
+ */
+const size_t duplicates_linear_threshold = 16;
+
+/**
+ * Buffered input over arbitrary `Source`
+ */
+template<typename Source>
+class input {
+    Source src;
+    std::vector<char> buffer;
+    size_t consumed = 0;
+    size_t filled = 0;
+    bool exhausted = false;
+
+public:
+    // data pointers are invalidated on refill
+    static const bool in_place = false;
+
+    input(Source&& src) :
+    src(std::move(src)),
+    buffer(buffer_size) { }
+
+    input(const input&) = delete;
+
+    input& operator=(const input&) = delete;
+
+    input(input&& other) :
+    src(std::move(other.src)),
+    buffer(std::move(other.buffer)),
+    consumed(other.consumed),
+    filled(other.filled),
+    exhausted(other.exhausted) { }
+
+    const char* begin() const {
+        return buffer.data();
+    }
+
+    size_t offset() const {
+        return consumed;
+    }
+
+    bool refill(const char*& pos, const char*& end) {
+        if (exhausted) {
+            return false;
+        }
+        consumed += filled;
+        filled = 0;
+        std::streamsize res = 0;
+        while (0 == res) {
+            res = src.read({buffer.data(), buffer.size()});
+        }
+        if (std::char_traits<char>::eof() == res) {
+            exhausted = true;
+            pos = buffer.data();
+            end = buffer.data();
+            return false;
+        }
+        filled = static_cast<size_t> (res);
+        pos = buffer.data();
+        end = buffer.data() + filled;
+        return true;
+    }
+
+    Source& get_source() {
+        return src;
+    }
+};
+
+/**
+ * Non-buffered input over the memory span, input data is not copied
+ */
+template<>
+class input<sl::io::span<const char>> {
+    sl::io::span<const char> span;
+    bool exhausted = false;
+
+public:
+    // data pointers point into the input span
+    static const bool in_place = true;
+
+    input(sl::io::span<const char>&& span) :
+    span(span) { }
+
+    input(const input&) = delete;
+
+    input& operator=(const input&) = delete;
+
+    input(input&& other) :
+    span(other.span),
+    exhausted(other.exhausted) { }
+
+    const char* begin() const {
+        return span.data();
+    }
+
+    size_t offset() const {
+        return 0;
+    }
+
+    bool refill(const char*& pos, const char*& end) {
+        if (exhausted) {
+            return false;
+        }
+        exhausted = true;
+        pos = span.data();
+        end = span.data() + span.size();
+        return pos != end;
+    }
+};
+
+/**
+ * Returns the length of UTF-8 sequence by its first byte,
+ * returns zero for bytes that cannot start a sequence
+ *
+ * @param first first byte of the sequence
+ * @return length of the sequence
+ */
+inline size_t utf8_sequence_length(unsigned char first) {
+    if (first < 0x80) {
+        return 1;
+    } else if (first < 0xc2) {
+        // continuation byte or overlong 2-byte sequence
+        return 0;
+    } else if (first < 0xe0) {
+        return 2;
+    } else if (first < 0xf0) {
+        return 3;
+    } else if (first < 0xf5) {
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * Checks that multibyte UTF-8 sequence is well formed and
+ * is not an overlong form or a surrogate
+ *
+ * @param seq sequence bytes
+ * @param len sequence length as returned by 'utf8_sequence_length'
+ * @return whether sequence is valid
+ */
+inline bool utf8_sequence_valid(const unsigned char* seq, size_t len) {
+    for (size_t i = 1; i < len; i++) {
+        if (0x80 != (seq[i] & 0xc0)) {
+            return false;
+        }
+    }
+    switch (seq[0]) {
+    case 0xe0: return seq[1] >= 0xa0;
+    case 0xed: return seq[1] < 0xa0;
+    case 0xf0: return seq[1] >= 0x90;
+    case 0xf4: return seq[1] < 0x90;
+    default: return true;
+    }
+}
+
+/**
+ * Appends specified code point to the string encoded as UTF-8
+ *
+ * @param cp code point
+ * @param dest destination string
+ */
+inline void utf8_append(uint32_t cp, std::string& dest) {
+    if (cp < 0x80) {
+        dest.push_back(static_cast<char> (cp));
+    } else if (cp < 0x800) {
+        dest.push_back(static_cast<char> (0xc0 | (cp >> 6)));
+        dest.push_back(static_cast<char> (0x80 | (cp & 0x3f)));
+    } else if (cp < 0x10000) {
+        dest.push_back(static_cast<char> (0xe0 | (cp >> 12)));
+        dest.push_back(static_cast<char> (0x80 | ((cp >> 6) & 0x3f)));
+        dest.push_back(static_cast<char> (0x80 | (cp & 0x3f)));
+    } else {
+        dest.push_back(static_cast<char> (0xf0 | (cp >> 18)));
+        dest.push_back(static_cast<char> (0x80 | ((cp >> 12) & 0x3f)));
+        dest.push_back(static_cast<char> (0x80 | ((cp >> 6) & 0x3f)));
+        dest.push_back(static_cast<char> (0x80 | (cp & 0x3f)));
+    }
+}
+
+/**
+ * Checks whether specified byte can be copied to the unescaped
+ * string as is (printable ASCII that is not a quote or a backslash)
+ *
+ * @param ch byte to check
+ * @return whether byte needs no special handling
+ */
+inline bool is_plain_string_byte(unsigned char ch) {
+    return ch >= 0x20 && ch < 0x80 && '"' != ch && '\\' != ch;
+}
+
+/**
+ * Finds the end of the run of plain string bytes (see `is_plain_string_byte`),
+ * scans 16 or 32 bytes at a time on x86 using SSE2 or AVX2 (selected at runtime)
+ *
+ * @param pos start of the data
+ * @param end end of the data
+ * @return pointer to the first non-plain byte, or `end`
+ */
+const char* find_string_special(const char* pos, const char* end);
+
+/**
+ * Finds the end of the run of whitespace bytes counting line feeds in it,
+ * scans 16 or 32 bytes at a time on x86 using SSE2 or AVX2 (selected at runtime)
+ *
+ * @param pos start of the data
+ * @param end end of the data
+ * @param lines number of line feeds found is added to this counter
+ * @param last_line_feed set to the last line feed found, not changed if there are none
+ * @return pointer to the first non-whitespace byte, or `end`
+ */
+const char* skip_whitespace(const char* pos, const char* end, size_t& lines, const char*& last_line_feed);
+
+/**
+ * Finds the first quote or bracket byte,
+ * scans 16 or 32 bytes at a time on x86 using SSE2 or AVX2 (selected at runtime)
+ *
+ * @param pos start of the data
+ * @param end end of the data
+ * @return pointer to the first '"', '{', '}', '[' or ']' byte, or `end`
+ */
+const char* find_structural(const char* pos, const char* end);
+
+/**
+ * Converts decimal number `w * 10^q` to the nearest `double` using
+ * Eisel-Lemire algorithm (Daniel Lemire, "Number Parsing at a Gigabyte per Second",
+ * Software: Practice and Experience 51 (8), 2021), result is correctly rounded,
+ * overflow produces infinity and underflow produces zero
+ *
+ * @param w decimal significand
+ * @param q decimal exponent
+ * @param negative whether the result is negative
+ * @param res converted number
+ * @return false in (very rare) cases when the number is too close to the halfway
+ *         point between two doubles, and cannot be converted this way
+ */
+bool decimal_to_double(uint64_t w, int64_t q, bool negative, double& res);
+
+/**
+ * Converts valid JSON integer number to `int64_t`
+ *
+ * @param num number data, must conform to JSON number grammar
+ * @param len number length
+ * @param res converted number
+ * @return false if number does not fit into `int64_t`
+ */
+inline bool parse_integer(const char* num, size_t len, int64_t& res) {
+    bool negative = '-' == num[0];
+    size_t start = negative ? 1 : 0;
+    // there are no leading zeroes, so longer numbers do not fit
+    if (len - start > 19) {
+        return false;
+    }
+    // any 19 digits fit into uint64_t
+    uint64_t acc = 0;
+    for (size_t i = start; i < len; i++) {
+        acc = acc * 10 + static_cast<uint64_t> (num[i] - '0');
+    }
+    const uint64_t max = static_cast<uint64_t> (std::numeric_limits<int64_t>::max());
+    if (negative) {
+        if (acc > max + 1) {
+            return false;
+        }
+        // unsigned negation covers int64_t::min()
+        acc = 0 - acc;
+        std::memcpy(std::addressof(res), std::addressof(acc), sizeof(res));
+        return true;
+    }
+    if (acc > max) {
+        return false;
+    }
+    res = static_cast<int64_t> (acc);
+    return true;
+}
+
+/**
+ * Converts valid JSON integer number to `int64_t`
+ *
+ * @param num number string, must conform to JSON number grammar
+ * @param res converted number
+ * @return false if number does not fit into `int64_t`
+ */
+inline bool parse_integer(const std::string& num, int64_t& res) {
+    return parse_integer(num.data(), num.length(), res);
+}
+
+/**
+ * Converts valid JSON real number to `double` using `strtod`,
+ * is used only for the numbers that cannot be converted exactly
+ * with `decimal_to_double`
+ *
+ * @param num number data, must conform to JSON number grammar
+ * @param len number length
+ * @param res converted number
+ * @return false on overflow
+ */
+inline bool parse_real_strtod(const char* num, size_t len, double& res) {
+    auto str = std::string(num, len);
+    // strtod is locale-dependent, see jansson's jsonp_strtod
+    const char* point = std::localeconv()->decimal_point;
+    if ('.' != point[0]) {
+        size_t idx = str.find('.');
+        if (std::string::npos != idx) {
+            str[idx] = point[0];
+        }
+    }
+    errno = 0;
+    res = std::strtod(str.c_str(), nullptr);
+    return !(ERANGE == errno && (res == HUGE_VAL || res == -HUGE_VAL));
+}
+
+/**
+ * Converts valid JSON real number to `double`, does not depend on the current locale
+ *
+ * @param num number data, must conform to JSON number grammar
+ * @param len number length
+ * @param res converted number
+ * @return false on overflow
+ */
+inline bool parse_real(const char* num, size_t len, double& res) {
+    const char* cur = num;
+    const char* end = num + len;
+    bool negative = '-' == *cur;
+    if (negative) {
+        cur += 1;
+    }
+    uint64_t w = 0;
+    int64_t q = 0;
+    size_t digits = 0;
+    for (; cur < end && *cur >= '0' && *cur <= '9'; cur++) {
+        w = w * 10 + static_cast<uint64_t> (*cur - '0');
+        // leading zeroes are not significant
+        digits += 0 != w ? 1 : 0;
+    }
+    if (cur < end && '.' == *cur) {
+        cur += 1;
+        for (; cur < end && *cur >= '0' && *cur <= '9'; cur++) {
+            w = w * 10 + static_cast<uint64_t> (*cur - '0');
+            digits += 0 != w ? 1 : 0;
+            q -= 1;
+        }
+    }
+    if (digits > 19) {
+        // significand does not fit, rare in practice
+        return parse_real_strtod(num, len, res);
+    }
+    if (cur < end) {
+        // exponent
+        cur += 1;
+        bool exp_negative = '-' == *cur;
+        if ('-' == *cur || '+' == *cur) {
+            cur += 1;
+        }
+        int64_t exp = 0;
+        for (; cur < end; cur++) {
+            // larger exponents give zero or infinity anyway
+            if (exp < 100000) {
+                exp = exp * 10 + (*cur - '0');
+            }
+        }
+        q += exp_negative ? -exp : exp;
+    }
+    if (!decimal_to_double(w, q, negative, res)) {
+        return parse_real_strtod(num, len, res);
+    }
+    return !(std::isinf(res));
+}
+
+/**
+ * Converts valid JSON real number to `double`, does not depend on the current locale
+ *
+ * @param num number string, must conform to JSON number grammar
+ * @param res converted number
+ * @return false on overflow
+ */
+inline bool parse_real(const std::string& num, double& res) {
+    return parse_real(num.data(), num.length(), res);
+}
+
+/**
+ * Hash of the object field name, fields are referenced by index
+ */
+class field_name_hash {
+    const std::vector<field>* fields;
+
+public:
+    field_name_hash(const std::vector<field>* fields) :
+    fields(fields) { }
+
+    size_t operator()(size_t idx) const {
+        return std::hash<std::string>()((*fields)[idx].name());
+    }
+};
+
+/**
+ * Equality of the object field names, fields are referenced by index
+ */
+class field_name_equal {
+    const std::vector<field>* fields;
+
+public:
+    field_name_equal(const std::vector<field>* fields) :
+    fields(fields) { }
+
+    bool operator()(size_t left, size_t right) const {
+        return (*fields)[left].name() == (*fields)[right].name();
+    }
+};
+
+/**
+ * Duplicate keys checker that does a linear scan for small objects
+ * and switches to a hash set of field indices for the large ones
+ */
+class duplicates_checker {
+    const std::vector<field>& fields;
+    std::unique_ptr<std::unordered_set<size_t, field_name_hash, field_name_equal>> index;
+
+public:
+    duplicates_checker(const std::vector<field>& fields) :
+    fields(fields) { }
+
+    duplicates_checker(const duplicates_checker&) = delete;
+
+    duplicates_checker& operator=(const duplicates_checker&) = delete;
+
+    /**
+     * Checks whether the last field of the object has the same name
+     * as one of the previous fields
+     *
+     * @return true if the name of the last field is a duplicate
+     */
+    bool last_is_duplicate() {
+        size_t last = fields.size() - 1;
+        if (nullptr == index.get()) {
+            const std::string& name = fields[last].name();
+            for (size_t i = 0; i < last; i++) {
+                const std::string& prev = fields[i].name();
+                if (std::addressof(name) == std::addressof(prev) || name == prev) {
+                    return true;
+                }
+            }
+            if (fields.size() > duplicates_linear_threshold) {
+                auto fptr = std::addressof(fields);
+                index.reset(new std::unordered_set<size_t, field_name_hash, field_name_equal>(
+                        fields.size() * 2, field_name_hash(fptr), field_name_equal(fptr)));
+                for (size_t i = 0; i <= last; i++) {
+                    index->insert(i);
+                }
+            }
+            return false;
+        }
+        return !index->insert(last).second;
+    }
+};
+
+} // namespace
+
+/**
+ * Single-pass JSON parser that builds `json::value` instances directly
+ * from the input data without any intermediate representation.
+ * Reads input data from the specified `Source` using the internal buffer,
+ * when `sl::io::span<const char>` is used as a `Source` - input data is
+ * parsed in place without copying.
+ *
+ * Follows the semantics of the Jansson-based parser used previously:
+ * rejects duplicate keys, preserves fields order, supports 'bare'
+ * (non-object, non-array) values and reads only the first JSON element
+ * from the input ignoring the data that follows it.
+ */
+template<typename Source>
+class parser {
+    detail_parser::input<Source> in;
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    size_t line = 1;
+    size_t line_start = 0;
+    std::string numbuf;
+    std::string strbuf;
+    bool borrow = false;
+    bool unescape_in_place = false;
+    key_pool* keys = nullptr;
+    bool pack_numbers = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src input source
+     */
+    parser(Source&& src) :
+    in(std::move(src)) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    parser(const parser&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    parser& operator=(const parser&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    parser(parser&& other) :
+    in(std::move(other.in)),
+    pos(other.pos),
+    end(other.end),
+    line(other.line),
+    line_start(other.line_start),
+    numbuf(std::move(other.numbuf)),
+    strbuf(std::move(other.strbuf)),
+    borrow(other.borrow),
+    unescape_in_place(other.unescape_in_place),
+    keys(other.keys),
+    pack_numbers(other.pack_numbers) { }
+
+    /**
+     * Enables creation of `STRING` values that borrow their data from
+     * the input span (see `value::borrowed_string`) for the strings that
+     * need no unescaping, can be used only with `sl::io::span<const char>` input
+     *
+     * @param enabled whether string values should borrow input data
+     */
+    void set_borrow_strings(bool enabled) {
+        static_assert(detail_parser::input<Source>::in_place,
+                "Strings can be borrowed only from 'sl::io::span<const char>' input");
+        borrow = enabled;
+    }
+
+    /**
+     * Enables in-situ decoding of string values: strings are unescaped
+     * directly in the input buffer and string values borrow their data from
+     * it (see `value::borrowed_string`). Input span must point to the mutable
+     * memory, its contents are changed during parsing.
+     * Can be used only with `sl::io::span<const char>` input.
+     *
+     * @param enabled whether string values should be unescaped in place
+     */
+    void set_unescape_in_place(bool enabled) {
+        static_assert(detail_parser::input<Source>::in_place,
+                "Strings can be unescaped in place only in 'sl::io::span<const char>' input");
+        unescape_in_place = enabled;
+    }
+
+    /**
+     * Sets the pool to intern object field names with, fields with the same
+     * name share the single copy of it (see `key_pool`)
+     *
+     * @param pool names pool, `nullptr` to copy names into each field
+     */
+    void set_key_pool(key_pool* pool) {
+        keys = pool;
+    }
+
+    /**
+     * Enables packing of the non-empty arrays that contain only integers
+     * or only real numbers (see `value::packed_int64_array`)
+     *
+     * @param enabled whether numeric arrays should be packed
+     */
+    void set_pack_numeric_arrays(bool enabled) {
+        pack_numbers = enabled;
+    }
+
+    /**
+     * Parses a single JSON value from input,
+     * input data after the end of the value is not checked
+     *
+     * @return parsed value
+     * @throws json_exception
+     */
+    value parse() {
+        return parse_value(0);
+    }
+
+    /**
+     * Parses a single JSON value that is nested into the specified
+     * number of already open containers, maximum depth is checked
+     * against the total nesting level
+     *
+     * @param depth number of enclosing containers
+     * @return parsed value
+     * @throws json_exception
+     */
+    value parse_nested(size_t depth) {
+        return parse_value(depth);
+    }
+
+    /**
+     * Parses a single JSON value from input reporting its contents
+     * to the specified handler as a sequence of events, no `json::value`
+     * instances are created.
+     * Handler must have the following methods:
+     *
+     * - `start_object()`
+     * - `key(const std::string& name)`
+     * - `end_object()`
+     * - `start_array()`
+     * - `end_array()`
+     * - `string(const std::string& val)`
+     * - `integer(int64_t val)`
+     * - `real(double val)`
+     * - `boolean(bool val)`
+     * - `null()`
+     *
+     * String references passed to handler are valid only until the
+     * method returns. Duplicate keys in objects are NOT checked.
+     * Handler may throw an exception to stop parsing.
+     *
+     * @param handler events handler
+     * @throws json_exception
+     */
+    template<typename Handler>
+    void parse(Handler& handler) {
+        parse_events(handler, 0);
+    }
+
+    /**
+     * Skips whitespace and returns the next input byte without consuming it
+     *
+     * @return next non-whitespace byte, or `-1` on end of input
+     */
+    int peek() {
+        for (;;) {
+            while (pos < end) {
+                char ch = *pos;
+                switch (ch) {
+                case ' ': case '\t': case '\r':
+                    pos += 1;
+                    break;
+                case '\n': {
+                    // pretty-printed input, skip indentation in bulk
+                    const char* last_line_feed = pos;
+                    size_t lines = 0;
+                    pos = detail_parser::skip_whitespace(pos, end, lines, last_line_feed);
+                    line += lines;
+                    line_start = in.offset() + static_cast<size_t> (last_line_feed - in.begin()) + 1;
+                    break;
+                }
+                default:
+                    return static_cast<unsigned char> (ch);
+                }
+            }
+            if (!in.refill(pos, end)) {
+                return -1;
+            }
+        }
+    }
+
+    /**
+     * Skips whitespace within the current line and returns the next
+     * input byte without consuming it, line feed is not skipped
+     *
+     * @return next non-whitespace byte, or `-1` on end of input
+     */
+    int peek_line() {
+        for (;;) {
+            while (pos < end) {
+                char ch = *pos;
+                if (' ' != ch && '\t' != ch && '\r' != ch) {
+                    return static_cast<unsigned char> (ch);
+                }
+                pos += 1;
+            }
+            if (!in.refill(pos, end)) {
+                return -1;
+            }
+        }
+    }
+
+    /**
+     * Consumes one byte previously returned by 'peek'
+     */
+    void consume() {
+        pos += 1;
+    }
+
+    /**
+     * Reads JSON string at the current position into the specified destination
+     * unescaping it and checking that it is a valid UTF-8
+     *
+     * @param dest destination string, is not cleared before reading
+     * @throws json_exception
+     */
+    void read_string(std::string& dest) {
+        // opening quote
+        pos += 1;
+        for (;;) {
+            const char* run = pos;
+            pos = detail_parser::find_string_special(pos, end);
+            if (pos > run) {
+                dest.append(run, static_cast<size_t> (pos - run));
+            }
+            int ch = next_byte();
+            switch (ch) {
+            case -1: throw make_error("premature end of input in string");
+            case '"': return;
+            case '\\': read_escape(dest);
+                break;
+            default:
+                if (ch < 0x20) {
+                    throw make_error("control character 0x" + to_hex(ch) + " in string");
+                }
+                read_utf8_tail(static_cast<unsigned char> (ch), dest);
+            }
+        }
+    }
+
+    /**
+     * Reads JSON number at the current position
+     *
+     * @return `INTEGER` or `REAL` value
+     * @throws json_exception
+     */
+    value read_number() {
+        int64_t integer = 0;
+        double real = 0;
+        if (type::real == read_number(integer, real)) {
+            return value(real);
+        }
+        return value(integer);
+    }
+
+    /**
+     * Reads JSON number at the current position without creating a value
+     *
+     * @param integer set to the number read if it is an integer
+     * @param real set to the number read if it is a real number
+     * @return `type::integer` or `type::real`
+     * @throws json_exception
+     */
+    type read_number(int64_t& integer, double& real) {
+        const char* num = nullptr;
+        size_t len = 0;
+        if (scan_number(num, len)) {
+            real = convert_real(num, len);
+            return type::real;
+        }
+        integer = convert_integer(num, len);
+        return type::integer;
+    }
+
+    /**
+     * Reads one of 'true', 'false' or 'null' literals at current position
+     *
+     * @return `BOOLEAN` or `NULL_T` value
+     * @throws json_exception
+     */
+    value read_literal() {
+        bool boolean = false;
+        if (type::boolean == read_literal(boolean)) {
+            return value(boolean);
+        }
+        return value();
+    }
+
+    /**
+     * Reads one of 'true', 'false' or 'null' literals at current position
+     * without creating a value
+     *
+     * @param boolean set to the literal read if it is 'true' or 'false'
+     * @return `type::boolean` or `type::nullt`
+     * @throws json_exception
+     */
+    type read_literal(bool& boolean) {
+        numbuf.clear();
+        int ch = current_byte();
+        while ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')) {
+            take(ch);
+            ch = current_byte();
+        }
+        if ("true" == numbuf) {
+            boolean = true;
+            return type::boolean;
+        } else if ("false" == numbuf) {
+            boolean = false;
+            return type::boolean;
+        } else if ("null" == numbuf) {
+            return type::nullt;
+        }
+        throw make_error("invalid token");
+    }
+
+    /**
+     * Creates an exception with the specified message
+     * and the current input position
+     *
+     * @param text error message
+     * @return exception instance
+     */
+    json_exception make_error(const std::string& text) {
+        size_t position = this->position();
+        return json_exception(TRACEMSG("Error parsing JSON:" +
+                " text: [" + text + "]" +
+                " line: [" + sl::support::to_string(line) + "]" +
+                " column: [" + sl::support::to_string(position - line_start + 1) + "]" +
+                " position: [" + sl::support::to_string(position) + "]"));
+    }
+
+    /**
+     * Number of bytes read from input
+     *
+     * @return current position
+     */
+    size_t position() const {
+        return in.offset() + static_cast<size_t> (pos - in.begin());
+    }
+
+private:
+    // number data is referenced in the input buffer when the whole number
+    // is available there, and is copied into numbuf otherwise
+    bool scan_number(const char*& num, size_t& len) {
+        bool real = false;
+        const char* num_end = scan_number_in_buffer(real);
+        if (nullptr != num_end) {
+            num = pos;
+            len = static_cast<size_t> (num_end - pos);
+            pos = num_end;
+            return real;
+        }
+        real = copy_number();
+        num = numbuf.data();
+        len = numbuf.length();
+        return real;
+    }
+
+    // returns nullptr if number is invalid or may continue after the buffer end,
+    // such numbers are handled by copy_number
+    const char* scan_number_in_buffer(bool& real) {
+        const char* cur = pos;
+        if (cur < end && '-' == *cur) {
+            cur += 1;
+        }
+        if (cur == end) {
+            return nullptr;
+        }
+        if ('0' == *cur) {
+            cur += 1;
+        } else if (is_digit(*cur)) {
+            cur = skip_digits(cur);
+        } else {
+            return nullptr;
+        }
+        if (cur < end && '.' == *cur) {
+            real = true;
+            cur += 1;
+            if (cur == end || !is_digit(*cur)) {
+                return nullptr;
+            }
+            cur = skip_digits(cur);
+        }
+        if (cur < end && ('e' == *cur || 'E' == *cur)) {
+            real = true;
+            cur += 1;
+            if (cur < end && ('+' == *cur || '-' == *cur)) {
+                cur += 1;
+            }
+            if (cur == end || !is_digit(*cur)) {
+                return nullptr;
+            }
+            cur = skip_digits(cur);
+        }
+        if (cur == end && !detail_parser::input<Source>::in_place) {
+            return nullptr;
+        }
+        // leading zeroes
+        if (cur < end && is_digit(*cur)) {
+            return nullptr;
+        }
+        return cur;
+    }
+
+    const char* skip_digits(const char* cur) {
+        while (cur < end && is_digit(*cur)) {
+            cur += 1;
+        }
+        return cur;
+    }
+
+    bool copy_number() {
+        numbuf.clear();
+        bool real = false;
+        int ch = current_byte();
+        if ('-' == ch) {
+            take(ch);
+            ch = current_byte();
+        }
+        if ('0' == ch) {
+            take(ch);
+            ch = current_byte();
+            if (is_digit(ch)) {
+                throw make_error("invalid number, leading zeroes are not allowed");
+            }
+        } else if (is_digit(ch)) {
+            ch = take_digits();
+        } else {
+            throw make_error("invalid token");
+        }
+        if ('.' == ch) {
+            real = true;
+            take(ch);
+            if (!is_digit(current_byte())) {
+                throw make_error("invalid number, digit expected after decimal point");
+            }
+            ch = take_digits();
+        }
+        if ('e' == ch || 'E' == ch) {
+            real = true;
+            take(ch);
+            ch = current_byte();
+            if ('+' == ch || '-' == ch) {
+                take(ch);
+            }
+            if (!is_digit(current_byte())) {
+                throw make_error("invalid number, digit expected in exponent");
+            }
+            take_digits();
+        }
+        return real;
+    }
+
+    template<typename Handler>
+    void parse_events(Handler& handler, size_t depth) {
+        int ch = peek();
+        switch (ch) {
+        case '{': parse_object_events(handler, depth);
+            break;
+        case '[': parse_array_events(handler, depth);
+            break;
+        case '"':
+            strbuf.clear();
+            read_string(strbuf);
+            handler.string(static_cast<const std::string&> (strbuf));
+            break;
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9': {
+            int64_t integer = 0;
+            double real = 0;
+            if (type::real == read_number(integer, real)) {
+                handler.real(real);
+            } else {
+                handler.integer(integer);
+            }
+            break;
+        }
+        case -1: throw make_error("unexpected end of input");
+        default: {
+            bool boolean = false;
+            if (type::boolean == read_literal(boolean)) {
+                handler.boolean(boolean);
+            } else {
+                handler.null();
+            }
+        }
+        }
+    }
+
+    template<typename Handler>
+    void parse_object_events(Handler& handler, size_t depth) {
+        check_depth(depth);
+        consume();
+        handler.start_object();
+        int ch = peek();
+        if ('}' == ch) {
+            consume();
+            handler.end_object();
+            return;
+        }
+        for (;;) {
+            if ('"' != ch) {
+                throw make_error("string or '}' expected");
+            }
+            strbuf.clear();
+            read_string(strbuf);
+            handler.key(static_cast<const std::string&> (strbuf));
+            if (':' != peek()) {
+                throw make_error("':' expected");
+            }
+            consume();
+            parse_events(handler, depth + 1);
+            ch = peek();
+            if ('}' == ch) {
+                consume();
+                handler.end_object();
+                return;
+            }
+            if (',' != ch) {
+                throw make_error("'}' expected");
+            }
+            consume();
+            ch = peek();
+        }
+    }
+
+    template<typename Handler>
+    void parse_array_events(Handler& handler, size_t depth) {
+        check_depth(depth);
+        consume();
+        handler.start_array();
+        int ch = peek();
+        if (']' == ch) {
+            consume();
+            handler.end_array();
+            return;
+        }
+        for (;;) {
+            parse_events(handler, depth + 1);
+            ch = peek();
+            if (']' == ch) {
+                consume();
+                handler.end_array();
+                return;
+            }
+            if (',' != ch) {
+                throw make_error("']' expected");
+            }
+            consume();
+        }
+    }
+
+    value parse_value(size_t depth) {
+        int ch = peek();
+        switch (ch) {
+        case '{': return parse_object(depth);
+        case '[': return parse_array(depth);
+        case '"': return read_string_value();
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return read_number();
+        case -1: throw make_error("unexpected end of input");
+        default: return read_literal();
+        }
+    }
+
+    value parse_object(size_t depth) {
+        check_depth(depth);
+        consume();
+        auto fields = std::vector<field>();
+        int ch = peek();
+        if ('}' == ch) {
+            consume();
+            return value(std::move(fields));
+        }
+        detail_parser::duplicates_checker checker(fields);
+        for (;;) {
+            if ('"' != ch) {
+                throw make_error("string or '}' expected");
+            }
+            std::string name;
+            read_string(name);
+            if (':' != peek()) {
+                throw make_error("':' expected");
+            }
+            consume();
+            value val = parse_value(depth + 1);
+            if (nullptr != keys) {
+                fields.emplace_back(keys->make_field(name, std::move(val)));
+            } else {
+                fields.emplace_back(std::move(name), std::move(val));
+            }
+            if (checker.last_is_duplicate()) {
+                throw make_error("duplicate object key: [" + fields.back().name() + "]");
+            }
+            ch = peek();
+            if ('}' == ch) {
+                consume();
+                return value(std::move(fields));
+            }
+            if (',' != ch) {
+                throw make_error("'}' expected");
+            }
+            consume();
+            ch = peek();
+        }
+    }
+
+    value parse_array(size_t depth) {
+        check_depth(depth);
+        consume();
+        auto values = std::vector<value>();
+        int ch = peek();
+        if (']' == ch) {
+            consume();
+            return value(std::move(values));
+        }
+        for (;;) {
+            values.emplace_back(parse_value(depth + 1));
+            ch = peek();
+            if (']' == ch) {
+                consume();
+                return make_array(std::move(values));
+            }
+            if (',' != ch) {
+                throw make_error("']' expected");
+            }
+            consume();
+        }
+    }
+
+    value read_string_value() {
+        if (unescape_in_place) {
+            return read_string_in_place();
+        }
+        if (borrow) {
+            const char* start = pos + 1;
+            const char* cur = start;
+            for (;;) {
+                cur = detail_parser::find_string_special(cur, end);
+                if (cur == end) {
+                    break;
+                }
+                unsigned char ch = static_cast<unsigned char> (*cur);
+                if ('"' == ch) {
+                    pos = cur + 1;
+                    return value::borrowed_string({start, static_cast<size_t> (cur - start)});
+                }
+                // escapes and errors are handled below
+                if (ch < 0x80) {
+                    break;
+                }
+                size_t len = detail_parser::utf8_sequence_length(ch);
+                if (0 == len || static_cast<size_t> (end - cur) < len ||
+                        !detail_parser::utf8_sequence_valid(reinterpret_cast<const unsigned char*> (cur), len)) {
+                    break;
+                }
+                cur += len;
+            }
+        }
+        std::string str;
+        read_string(str);
+        return value(std::move(str));
+    }
+
+    value make_array(std::vector<value>&& values) {
+        if (!pack_numbers) {
+            return value(std::move(values));
+        }
+        type kind = values.front().json_type();
+        if (type::integer != kind && type::real != kind) {
+            return value(std::move(values));
+        }
+        for (const value& el : values) {
+            if (kind != el.json_type()) {
+                return value(std::move(values));
+            }
+        }
+        if (type::integer == kind) {
+            auto numbers = std::vector<int64_t>();
+            numbers.reserve(values.size());
+            for (const value& el : values) {
+                numbers.push_back(el.as_int64());
+            }
+            return value::packed_int64_array(std::move(numbers));
+        }
+        auto numbers = std::vector<double>();
+        numbers.reserve(values.size());
+        for (const value& el : values) {
+            numbers.push_back(el.as_double());
+        }
+        return value::packed_double_array(std::move(numbers));
+    }
+
+    value read_string_in_place() {
+        // unescaped string is never longer than the escaped one,
+        // so output can be written behind the input position
+        char* start = const_cast<char*> (pos + 1);
+        char* out = start;
+        const char* cur = start;
+        for (;;) {
+            const char* run = cur;
+            cur = detail_parser::find_string_special(cur, end);
+            // valid UTF-8 sequences are copied as a part of the run
+            while (cur < end && static_cast<unsigned char> (*cur) >= 0x80) {
+                size_t len = detail_parser::utf8_sequence_length(static_cast<unsigned char> (*cur));
+                if (0 == len || static_cast<size_t> (end - cur) < len ||
+                        !detail_parser::utf8_sequence_valid(reinterpret_cast<const unsigned char*> (cur), len)) {
+                    break;
+                }
+                cur = detail_parser::find_string_special(cur + len, end);
+            }
+            size_t run_len = static_cast<size_t> (cur - run);
+            if (out != run && run_len > 0) {
+                std::memmove(out, run, run_len);
+            }
+            out += run_len;
+            if (cur == end) {
+                pos = cur;
+                throw make_error("premature end of input in string");
+            }
+            unsigned char ch = static_cast<unsigned char> (*cur);
+            pos = cur + 1;
+            if ('"' == ch) {
+                return value::borrowed_string({start, static_cast<size_t> (out - start)});
+            }
+            strbuf.clear();
+            if ('\\' == ch) {
+                read_escape(strbuf);
+            } else if (ch < 0x20) {
+                throw make_error("control character 0x" + to_hex(ch) + " in string");
+            } else {
+                // throws on invalid sequence
+                read_utf8_tail(ch, strbuf);
+            }
+            std::memcpy(out, strbuf.data(), strbuf.length());
+            out += strbuf.length();
+            cur = pos;
+        }
+    }
+
+    void check_depth(size_t depth) {
+        if (depth >= detail_parser::max_depth) {
+            throw make_error("maximum parsing depth reached");
+        }
+    }
+
+    int current_byte() {
+        if (pos < end || in.refill(pos, end)) {
+            return static_cast<unsigned char> (*pos);
+        }
+        return -1;
+    }
+
+    int next_byte() {
+        int res = current_byte();
+        if (-1 != res) {
+            pos += 1;
+        }
+        return res;
+    }
+
+    static bool is_digit(int ch) {
+        return ch >= '0' && ch <= '9';
+    }
+
+    void take(int ch) {
+        numbuf.push_back(static_cast<char> (ch));
+        pos += 1;
+    }
+
+    int take_digits() {
+        int ch = current_byte();
+        while (is_digit(ch)) {
+            take(ch);
+            ch = current_byte();
+        }
+        return ch;
+    }
+
+    int64_t convert_integer(const char* num, size_t len) {
+        int64_t res = 0;
+        if (!detail_parser::parse_integer(num, len, res)) {
+            throw make_error('-' == num[0] ? "too big negative integer" : "too big integer");
+        }
+        return res;
+    }
+
+    double convert_real(const char* num, size_t len) {
+        double res = 0;
+        if (!detail_parser::parse_real(num, len, res)) {
+            throw make_error("real number overflow");
+        }
+        return res;
+    }
+
+    void read_escape(std::string& dest) {
+        int ch = next_byte();
+        switch (ch) {
+        case '"': dest.push_back('"');
+            break;
+        case '\\': dest.push_back('\\');
+            break;
+        case '/': dest.push_back('/');
+            break;
+        case 'b': dest.push_back('\b');
+            break;
+        case 'f': dest.push_back('\f');
+            break;
+        case 'n': dest.push_back('\n');
+            break;
+        case 'r': dest.push_back('\r');
+            break;
+        case 't': dest.push_back('\t');
+            break;
+        case 'u': read_unicode_escape(dest);
+            break;
+        case -1: throw make_error("premature end of input in string");
+        default: throw make_error("invalid escape");
+        }
+    }
+
+    void read_unicode_escape(std::string& dest) {
+        uint32_t cp = read_hex4();
+        if (cp >= 0xd800 && cp <= 0xdbff) {
+            // surrogate pair
+            if ('\\' != next_byte() || 'u' != next_byte()) {
+                throw make_error("invalid Unicode, low surrogate expected after: [" + to_hex(cp) + "]");
+            }
+            uint32_t low = read_hex4();
+            if (low < 0xdc00 || low > 0xdfff) {
+                throw make_error("invalid Unicode, low surrogate expected after: [" + to_hex(cp) + "]");
+            }
+            cp = (((cp - 0xd800) << 10) | (low - 0xdc00)) + 0x10000;
+        } else if (cp >= 0xdc00 && cp <= 0xdfff) {
+            throw make_error("invalid Unicode: [" + to_hex(cp) + "]");
+        } else if (0 == cp) {
+            throw make_error("\\u0000 is not allowed");
+        }
+        detail_parser::utf8_append(cp, dest);
+    }
+
+    uint32_t read_hex4() {
+        uint32_t res = 0;
+        for (size_t i = 0; i < 4; i++) {
+            int ch = next_byte();
+            uint32_t digit;
+            if (ch >= '0' && ch <= '9') {
+                digit = static_cast<uint32_t> (ch - '0');
+            } else if (ch >= 'a' && ch <= 'f') {
+                digit = static_cast<uint32_t> (ch - 'a' + 10);
+            } else if (ch >= 'A' && ch <= 'F') {
+                digit = static_cast<uint32_t> (ch - 'A' + 10);
+            } else {
+                throw make_error("invalid escape, hex digit expected");
+            }
+            res = (res << 4) | digit;
+        }
+        return res;
+    }
+
+    void read_utf8_tail(unsigned char first, std::string& dest) {
+        size_t len = detail_parser::utf8_sequence_length(first);
+        if (0 == len) {
+            throw make_error("unable to decode byte 0x" + to_hex(first));
+        }
+        unsigned char seq[4];
+        seq[0] = first;
+        for (size_t i = 1; i < len; i++) {
+            int ch = next_byte();
+            if (-1 == ch) {
+                throw make_error("premature end of input in string");
+            }
+            seq[i] = static_cast<unsigned char> (ch);
+        }
+        if (!detail_parser::utf8_sequence_valid(seq, len)) {
+            throw make_error("unable to decode byte 0x" + to_hex(first));
+        }
+        dest.append(reinterpret_cast<const char*> (seq), len);
+    }
+
+    static std::string to_hex(uint32_t num) {
+        static const char* digits = "0123456789abcdef";
+        std::string res;
+        do {
+            res.insert(res.begin(), digits[num & 0xf]);
+            num >>= 4;
+        } while (num > 0);
+        if (res.length() < 2) {
+            res.insert(res.begin(), '0');
+        }
+        return res;
+    }
+
+};
+
+/**
+ * Factory function for creating parsers,
+ * created parser will own specified source
+ *
+ * @param src input source
+ * @return parser instance
+ */
+template <typename Source,
+class = typename std::enable_if<!std::is_lvalue_reference<Source>::value>::type>
+parser<Source> make_parser(Source&& src) {
+    return parser<Source>(std::move(src));
+}
+
+/**
+ * Factory function for creating parsers,
+ * created parser will NOT own specified source
+ *
+ * @param src input source
+ * @return parser instance
+ */
+template <typename Source>
+parser<sl::io::reference_source<Source>> make_parser(Source& src) {
+    return parser<sl::io::reference_source<Source>> (sl::io::make_reference_source(src));
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_PARSER_HPP */
+
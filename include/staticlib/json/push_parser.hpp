@@ -0,0 +1,229 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   push_parser.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:34 AM
+ */
+
+#ifndef STATICLIB_JSON_PUSH_PARSER_HPP
+#define STATICLIB_JSON_PUSH_PARSER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/field.hpp"
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_push_parser {
+
+enum class expect {
+    value,
+    value_or_end,
+    key,
+    key_or_end,
+    colon,
+    comma_or_end
+};
+
+enum class lexeme {
+    none,
+    string,
+    string_escape,
+    string_unicode,
+    string_utf8,
+    number,
+    literal
+};
+
+/**
+ * Object or array under construction
+ */
+class frame {
+public:
+    bool object;
+    expect exp;
+    std::vector<field> fields;
+    std::vector<value> values;
+    std::string key;
+    detail_parser::duplicates_checker checker;
+
+    frame(bool object) :
+    object(object),
+    exp(object ? expect::key_or_end : expect::value_or_end),
+    checker(fields) { }
+
+    frame(const frame&) = delete;
+
+    frame& operator=(const frame&) = delete;
+};
+
+} // namespace
+
+/**
+ * Resumable JSON parser that accepts input data in arbitrary chunks,
+ * keeps its state between the calls and never waits for more input.
+ * Input may contain multiple JSON elements separated by whitespace,
+ * each completed top-level element is queued and can be taken with `pop_value()`.
+ * Values are built incrementally as data arrives, only the current
+ * string or number token is buffered.
+ *
+ * Follows the semantics of the `json::load`: rejects duplicate keys,
+ * preserves fields order and supports 'bare' (non-object, non-array) values.
+ * After the parsing error all subsequent calls to `feed` will throw.
+ */
+class push_parser {
+    std::deque<detail_push_parser::frame> stack;
+    std::deque<value> completed;
+    detail_push_parser::lexeme lex = detail_push_parser::lexeme::none;
+    bool string_is_key = false;
+    std::string strbuf;
+    std::string tokbuf;
+    uint32_t unicode_cp = 0;
+    size_t unicode_digits = 0;
+    uint32_t high_surrogate = 0;
+    unsigned char utf8_seq[4];
+    size_t utf8_len = 0;
+    size_t utf8_filled = 0;
+    size_t consumed = 0;
+    size_t current = 0;
+    size_t line = 1;
+    size_t line_start = 0;
+    bool failed = false;
+
+public:
+    /**
+     * Constructor
+     */
+    push_parser();
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    push_parser(const push_parser&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    push_parser& operator=(const push_parser&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    push_parser(push_parser&& other);
+
+    /**
+     * Parses specified chunk of input data
+     *
+     * @param chunk input data
+     * @return number of completed values available with `pop_value()`
+     * @throws json_exception
+     */
+    size_t feed(sl::io::span<const char> chunk);
+
+    /**
+     * Signals the end of input, completes top-level number
+     * or literal that has no data after it
+     *
+     * @return number of completed values available with `pop_value()`
+     * @throws json_exception if input ends in the middle of a value
+     */
+    size_t finish();
+
+    /**
+     * Checks whether completed values are available
+     *
+     * @return true if `pop_value()` can be called
+     */
+    bool has_value() const;
+
+    /**
+     * Takes the first completed value from the queue
+     *
+     * @return completed value
+     * @throws json_exception if no completed values available
+     */
+    value pop_value();
+
+    /**
+     * Checks whether parser is in the middle of a value
+     *
+     * @return true if a value was started but not completed yet
+     */
+    bool in_progress() const;
+
+    /**
+     * Number of bytes passed to this parser
+     *
+     * @return current position
+     */
+    size_t position() const;
+
+private:
+    const char* copy_plain(const char* pos, const char* end);
+
+    void process_byte(char ch);
+
+    void process_string(char ch);
+
+    void process_escape(char ch);
+
+    void process_unicode(char ch);
+
+    void process_utf8(char ch);
+
+    void process_structural(char ch);
+
+    void start_value(char ch);
+
+    void close_container(char ch);
+
+    void complete_value(value&& val);
+
+    void complete_string();
+
+    void complete_number();
+
+    void complete_literal();
+
+    json_exception make_error(const std::string& text);
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_PUSH_PARSER_HPP */
+
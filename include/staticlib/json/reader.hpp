@@ -0,0 +1,482 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   reader.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 4:21 PM
+ */
+
+#ifndef STATICLIB_JSON_READER_HPP
+#define STATICLIB_JSON_READER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+/**
+ * @enum token
+ * Enumeration with all possible tokens returned by `json::reader`
+ */
+enum class token {
+    start_object,
+    key,
+    end_object,
+    start_array,
+    end_array,
+    string,
+    integer,
+    real,
+    boolean,
+    nullt,
+    end_of_input
+};
+
+/**
+ * Helper standalone function that converts `json::token` values into string representation.
+ *
+ * @param tok token enumeration value
+ * @return string representation of the specified value
+ */
+inline std::string stringify_json_token(token tok) {
+    switch (tok) {
+    case token::start_object: return "json::token::start_object";
+    case token::key: return "json::token::key";
+    case token::end_object: return "json::token::end_object";
+    case token::start_array: return "json::token::start_array";
+    case token::end_array: return "json::token::end_array";
+    case token::string: return "json::token::string";
+    case token::integer: return "json::token::integer";
+    case token::real: return "json::token::real";
+    case token::boolean: return "json::token::boolean";
+    case token::nullt: return "json::token::nullt";
+    case token::end_of_input: return "json::token::end_of_input";
+    default: return "unknown";
+    }
+}
+
+/**
+ * Pull-style JSON reader, allows to step through JSON input
+ * token by token, to skip unneeded values and to stop reading at any point.
+ * Reads the first JSON element from input, input data after the end
+ * of that element is not read.
+ * Scalar tokens are decoded into the reader itself and can be accessed
+ * with `get_*` methods until the next call to `next()`, no allocations
+ * are done for them once the internal string buffer is large enough.
+ * Duplicate keys in objects are NOT checked.
+ */
+template<typename Source>
+class reader {
+    enum class state {
+        expect_value,
+        expect_value_or_end,
+        expect_key,
+        expect_key_or_end,
+        expect_comma_or_end,
+        done
+    };
+
+    parser<Source> pr;
+    std::vector<char> stack;
+    state st = state::expect_value;
+    token current = token::end_of_input;
+    std::string string_val;
+    int64_t integer_val = 0;
+    double real_val = 0;
+    bool boolean_val = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src input source
+     */
+    reader(Source&& src) :
+    pr(std::move(src)) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    reader(const reader&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    reader& operator=(const reader&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    reader(reader&& other) :
+    pr(std::move(other.pr)),
+    stack(std::move(other.stack)),
+    st(other.st),
+    current(other.current),
+    string_val(std::move(other.string_val)),
+    integer_val(other.integer_val),
+    real_val(other.real_val),
+    boolean_val(other.boolean_val) { }
+
+    /**
+     * Reads next token from input
+     *
+     * @return token read, `end_of_input` after the end of the first JSON element
+     * @throws json_exception
+     */
+    token next() {
+        for (;;) {
+            switch (st) {
+            case state::done:
+                current = token::end_of_input;
+                return current;
+            case state::expect_value:
+                return read_value_token(pr.peek());
+            case state::expect_value_or_end: {
+                int ch = pr.peek();
+                if (']' == ch) {
+                    return read_end(ch);
+                }
+                return read_value_token(ch);
+            }
+            case state::expect_key:
+                return read_key(pr.peek());
+            case state::expect_key_or_end: {
+                int ch = pr.peek();
+                if ('}' == ch) {
+                    return read_end(ch);
+                }
+                return read_key(ch);
+            }
+            case state::expect_comma_or_end: {
+                int ch = pr.peek();
+                if (',' == ch) {
+                    pr.consume();
+                    st = '{' == stack.back() ? state::expect_key : state::expect_value;
+                    break;
+                }
+                return read_end(ch);
+            }
+            }
+        }
+    }
+
+    /**
+     * Skips next value, if reader is positioned before the object key,
+     * then both the key and its value are skipped
+     *
+     * @throws json_exception
+     */
+    void skip_value() {
+        token tok = next();
+        if (token::key == tok) {
+            tok = next();
+        }
+        if (token::start_object == tok || token::start_array == tok) {
+            size_t depth = stack.size();
+            while (stack.size() >= depth) {
+                next();
+            }
+        } else if (token::end_object == tok || token::end_array == tok || token::end_of_input == tok) {
+            throw pr.make_error("value expected, found: [" + stringify_json_token(tok) + "]");
+        }
+    }
+
+    /**
+     * Reads next value into `json::value` instance, if the end of
+     * the current container is found instead, then exception is
+     * thrown and the closing bracket is NOT consumed
+     *
+     * @return value read
+     * @throws json_exception
+     */
+    value read_value() {
+        for (;;) {
+            switch (st) {
+            case state::done:
+                throw pr.make_error("value expected, found: [" + stringify_json_token(token::end_of_input) + "]");
+            case state::expect_value:
+                return read_nested_value();
+            case state::expect_value_or_end:
+                if (']' == pr.peek()) {
+                    throw pr.make_error("value expected, found: [" + stringify_json_token(token::end_array) + "]");
+                }
+                return read_nested_value();
+            case state::expect_key:
+            case state::expect_key_or_end:
+                throw pr.make_error("value expected");
+            case state::expect_comma_or_end: {
+                int ch = pr.peek();
+                if (',' == ch) {
+                    pr.consume();
+                    st = '{' == stack.back() ? state::expect_key : state::expect_value;
+                    break;
+                }
+                bool obj = '{' == stack.back();
+                if ((obj && '}' == ch) || (!obj && ']' == ch)) {
+                    // bracket is left in input, reader can be used further
+                    token tok = obj ? token::end_object : token::end_array;
+                    throw pr.make_error("value expected, found: [" + stringify_json_token(tok) + "]");
+                }
+                throw pr.make_error(obj ? "',' or '}' expected" : "',' or ']' expected");
+            }
+            }
+        }
+    }
+
+    /**
+     * Reads next token that must be a `string` or a `key`
+     *
+     * @return string read, valid until the next call to `next()`
+     * @throws json_exception
+     */
+    const std::string& read_string() {
+        token tok = next();
+        if (token::string != tok && token::key != tok) {
+            throw unexpected(token::string, tok);
+        }
+        return string_val;
+    }
+
+    /**
+     * Reads next token that must be an `integer`
+     *
+     * @return integer read
+     * @throws json_exception
+     */
+    int64_t read_int64() {
+        token tok = next();
+        if (token::integer != tok) {
+            throw unexpected(token::integer, tok);
+        }
+        return integer_val;
+    }
+
+    /**
+     * Reads next token that must be a `real`
+     *
+     * @return real read
+     * @throws json_exception
+     */
+    double read_double() {
+        token tok = next();
+        if (token::real != tok) {
+            throw unexpected(token::real, tok);
+        }
+        return real_val;
+    }
+
+    /**
+     * Reads next token that must be a `boolean`
+     *
+     * @return boolean read
+     * @throws json_exception
+     */
+    bool read_bool() {
+        token tok = next();
+        if (token::boolean != tok) {
+            throw unexpected(token::boolean, tok);
+        }
+        return boolean_val;
+    }
+
+    /**
+     * Returns last token read
+     *
+     * @return last token
+     */
+    token current_token() const {
+        return current;
+    }
+
+    /**
+     * Returns current nesting level of objects and arrays
+     *
+     * @return nesting level
+     */
+    size_t depth() const {
+        return stack.size();
+    }
+
+    /**
+     * Accessor for the last `string` or `key` token
+     *
+     * @return string value
+     */
+    const std::string& get_string() const {
+        return string_val;
+    }
+
+    /**
+     * Accessor for the last `integer` token
+     *
+     * @return integer value
+     */
+    int64_t get_int64() const {
+        return integer_val;
+    }
+
+    /**
+     * Accessor for the last `real` token
+     *
+     * @return real value
+     */
+    double get_double() const {
+        return real_val;
+    }
+
+    /**
+     * Accessor for the last `boolean` token
+     *
+     * @return boolean value
+     */
+    bool get_bool() const {
+        return boolean_val;
+    }
+
+private:
+    token read_value_token(int ch) {
+        switch (ch) {
+        case '{': return read_start('{', token::start_object, state::expect_key_or_end);
+        case '[': return read_start('[', token::start_array, state::expect_value_or_end);
+        case '"':
+            string_val.clear();
+            pr.read_string(string_val);
+            return read_scalar(token::string);
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            if (type::integer == pr.read_number(integer_val, real_val)) {
+                return read_scalar(token::integer);
+            }
+            return read_scalar(token::real);
+        case -1: throw pr.make_error("unexpected end of input");
+        default:
+            if (type::boolean == pr.read_literal(boolean_val)) {
+                return read_scalar(token::boolean);
+            }
+            return read_scalar(token::nullt);
+        }
+    }
+
+    value read_nested_value() {
+        value res = pr.parse_nested(stack.size());
+        after_value();
+        current = token::end_of_input;
+        return res;
+    }
+
+    token read_start(char container, token tok, state next_state) {
+        if (stack.size() >= detail_parser::max_depth) {
+            throw pr.make_error("maximum parsing depth reached");
+        }
+        pr.consume();
+        stack.push_back(container);
+        st = next_state;
+        current = tok;
+        return tok;
+    }
+
+    token read_end(int ch) {
+        bool obj = '{' == stack.back();
+        if ((obj && '}' != ch) || (!obj && ']' != ch)) {
+            throw pr.make_error(obj ? "'}' expected" : "']' expected");
+        }
+        pr.consume();
+        stack.pop_back();
+        after_value();
+        current = obj ? token::end_object : token::end_array;
+        return current;
+    }
+
+    token read_key(int ch) {
+        if ('"' != ch) {
+            throw pr.make_error("string or '}' expected");
+        }
+        string_val.clear();
+        pr.read_string(string_val);
+        if (':' != pr.peek()) {
+            throw pr.make_error("':' expected");
+        }
+        pr.consume();
+        st = state::expect_value;
+        current = token::key;
+        return current;
+    }
+
+    token read_scalar(token tok) {
+        after_value();
+        current = tok;
+        return tok;
+    }
+
+    void after_value() {
+        st = stack.empty() ? state::done : state::expect_comma_or_end;
+    }
+
+    json_exception unexpected(token expected, token found) {
+        return pr.make_error("unexpected token, expected: [" + stringify_json_token(expected) + "]," +
+                " found: [" + stringify_json_token(found) + "]");
+    }
+
+};
+
+/**
+ * Factory function for creating readers,
+ * created reader will own specified source
+ *
+ * @param src input source
+ * @return reader instance
+ */
+template <typename Source,
+class = typename std::enable_if<!std::is_lvalue_reference<Source>::value>::type>
+reader<Source> make_reader(Source&& src) {
+    return reader<Source>(std::move(src));
+}
+
+/**
+ * Factory function for creating readers,
+ * created reader will NOT own specified source
+ *
+ * @param src input source
+ * @return reader instance
+ */
+template <typename Source>
+reader<sl::io::reference_source<Source>> make_reader(Source& src) {
+    return reader<sl::io::reference_source<Source>> (sl::io::make_reference_source(src));
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_READER_HPP */
+
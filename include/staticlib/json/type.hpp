@@ -34,8 +34,9 @@ namespace json {
  * @enum type
  * Enumeration with all possible types of values.
  * Matches types supported by Jansson JSON library.
+ * Stored as a single byte to keep `json::value` compact.
  */
-enum class type {
+enum class type : uint8_t {
     nullt,
     object,
     array,
@@ -32,6 +32,7 @@
 #include "staticlib/config.hpp"
 #include "staticlib/io.hpp"
 
+#include "staticlib/json/dump_options.hpp"
 #include "staticlib/json/type.hpp"
 #include "staticlib/json/json_exception.hpp"
 
@@ -42,6 +43,14 @@ namespace json {
 class field;
 class value;
 
+namespace detail_value {
+
+// forward declaration
+class array_node;
+class object_node;
+
+} // namespace
+
 /**
  * Representation of single arbitrary value for reflected classes.
  * Can represent any type of `type` enum. Always hold exactly one 
@@ -55,10 +64,45 @@ class value;
  * array and object fields of value (that is UB with `std::vector`).
  * `unique_ptr` cannot be used here instead of bare pointer because of lack of support for 
  * unrestricted unions in msvc 2013
+ * 
+ * `STRING` value can borrow its data from the external buffer (see `borrowed_string`),
+ * such value is converted into the owned one only on the first access through a mutable
+ * `std::string` reference (`as_string_or_throw` on non-const value, `set_string`).
+ * Const accessors do not change the borrowed data, `std::string` for them is created
+ * on the first const access and is published atomically, so concurrent const access
+ * is safe; `as_string_span` can be used to access string data without copying.
+ * 
+ * `OBJECT` with the number of fields not less than `set_object_index_threshold`
+ * keeps a hash index over field names, that is built lazily on the first lookup
+ * by name. Positions found in the index are checked against the field names, so
+ * fields can be changed through a mutable reference after the index was built.
+ * 
+ * `OBJECT` and `ARRAY` nodes can be shared between values created with `clone_shared`,
+ * shared node is copied (one level at a time) on the first access to it through
+ * a mutable reference.
+ * 
+ * `STRING` value up to 6 bytes long is stored inline in the value without heap
+ * allocations, longer strings are allocated on heap. Inline string gets its
+ * `std::string` the same way as the borrowed one, on the first access through
+ * `std::string` reference.
+ * 
+ * `ARRAY` of integers or of real numbers can be packed (see `packed_int64_array`),
+ * its elements are stored contiguously and are accessed with `as_int64_span` or
+ * `as_double_span`. Packed array is expanded into values lazily on the first
+ * access through `as_array`, expanded values are kept along with the packed
+ * numbers (spans returned earlier remain valid), so after such access the array
+ * takes the memory of both representations. Packed array is converted into
+ * a generic array (and packed numbers are freed) on the first access to it
+ * through a mutable reference.
  */
 class value {
 private:
     type value_type;
+    // length of the inline string data,
+    // or a marker of the heap or borrowed string data
+    uint8_t string_info = 0;
+    // inline string data, or the length of borrowed string data
+    char string_head[6];
     // boost::variant can be used instead (and implementation will be simpler)
     // but executable will be bigger, 
     // and we do not want to leak boost::variant from this public header
@@ -68,9 +112,11 @@ private:
         // direct std::vector is unsafe here
         // http://stackoverflow.com/q/18672135/314015
         // http://stackoverflow.com/q/8329826/314015
-        std::vector<field>* object_val;
-        std::vector<value>* array_val;
-        std::string* string_val;
+        detail_value::object_node* object_val;
+        detail_value::array_node* array_val;
+        // atomic word with the pointer to heap string, borrowed data
+        // is kept here until its std::string is published
+        char string_slot[sizeof(void*)];
         int64_t integer_val;
         double real_val;
         bool boolean_val;
@@ -110,6 +156,46 @@ public:
      */
     value& operator=(value&& other) STATICLIB_NOEXCEPT;
 
+    /**
+     * Creates `STRING` value that references specified data instead of copying it,
+     * data must be a valid UTF-8 and must outlive the returned value (and all values
+     * moved from it). Data longer than 4GB is copied.
+     * 
+     * @param data string data
+     * @return `STRING` value
+     */
+    static value borrowed_string(sl::io::span<const char> data);
+
+    /**
+     * Creates packed `ARRAY` value that stores integers contiguously
+     * (see `as_int64_span`) instead of storing a separate value for each element.
+     * Const access through `as_array` keeps both packed numbers and expanded values.
+     * 
+     * @param numbers array elements
+     * @return `ARRAY` value
+     */
+    static value packed_int64_array(std::vector<int64_t>&& numbers);
+
+    /**
+     * Creates packed `ARRAY` value that stores real numbers contiguously
+     * (see `as_double_span`) instead of storing a separate value for each element.
+     * Const access through `as_array` keeps both packed numbers and expanded values.
+     * 
+     * @param numbers array elements
+     * @return `ARRAY` value
+     */
+    static value packed_double_array(std::vector<double>&& numbers);
+
+    /**
+     * Sets the minimal number of fields in `OBJECT` values for which a hash
+     * index over field names is used by `getattr`, `operator[]` and `getattr_or_throw`.
+     * Smaller objects are searched linearly. Default threshold is 32 fields.
+     * 
+     * @param fields_count number of fields, `std::numeric_limits<size_t>::max()`
+     *        disables the index
+     */
+    static void set_object_index_threshold(size_t fields_count);
+
     /**
      * Constructs `NULL_T` value
      */
@@ -232,36 +318,70 @@ public:
     
     /**
      * Serializes this instance
-     * to JSON. JSON is written to the specified streambuf. Preserves order of object fields.
+     * to JSON. JSON is written to the specified streambuf. Preserves order of object fields
+     * unless `sort_keys` option is set.
      * 
      * @param dest streambuf to write JSON into
-     * @return JSON string
+     * @param options serialization options
      * @throws json_exception
      */
-    void dump(std::streambuf* dest) const;
+    void dump(std::streambuf* dest, const dump_options& options = dump_options()) const;
 
     /**
      * Serializes this instance to JSON. 
-     * JSON is written to the specified sink. Preserves order of object fields.
+     * JSON is written to the specified sink. Preserves order of object fields
+     * unless `sort_keys` option is set.
      * 
      * @param dest sink to write JSON into
-     * @return JSON string
+     * @param options serialization options
      * @throws json_exception
      */
     template <typename Sink>
-    void dump(Sink& dest) const {
+    void dump(Sink& dest, const dump_options& options = dump_options()) const {
         auto sbuf = sl::io::make_unbuffered_ostreambuf(dest);
-        dump(std::addressof(sbuf));
+        dump(std::addressof(sbuf), options);
     }
 
     /**
      * Serializes this instance
-     * to JSON string. Preserves order of object fields.
+     * to JSON string. Preserves order of object fields
+     * unless `sort_keys` option is set. String is allocated once
+     * with the size computed using `serialized_size`.
      * 
+     * @param options serialization options
      * @return JSON string
      * @throws json_exception
      */
-    std::string dumps() const;   
+    std::string dumps(const dump_options& options = dump_options()) const;
+
+    /**
+     * Serializes this instance to JSON writing it into the specified
+     * preallocated buffer. Does not allocate memory (except when `sort_keys`
+     * option is set). Output is not null-terminated.
+     * 
+     * Returns the size of the whole JSON, if it is greater than the size of the buffer,
+     * then the buffer was too small and its contents are unspecified, the call
+     * needs to be repeated with the buffer of (at least) the returned size.
+     * 
+     * @param dest buffer to write JSON into
+     * @param options serialization options
+     * @return number of bytes written, or number of bytes required
+     *         if it is greater than `dest.size()`
+     * @throws json_exception
+     */
+    size_t dump_to(sl::io::span<char> dest, const dump_options& options = dump_options()) const;
+
+    /**
+     * Computes the exact length of JSON that is written when this
+     * instance is serialized with the specified options. Does not allocate
+     * memory, traverses the whole value counting the lengths of strings and integers
+     * without formatting them, only real numbers are formatted.
+     * 
+     * @param options serialization options
+     * @return JSON length in bytes
+     * @throws json_exception if this instance cannot be serialized
+     */
+    size_t serialized_size(const dump_options& options = dump_options()) const;   
     
     /**
      * Explicit deep-copy method
@@ -270,6 +390,18 @@ public:
      */
     value clone() const;
 
+    /**
+     * Copy method that shares `OBJECT` and `ARRAY` nodes of this value with the
+     * returned copy instead of copying them, shared nodes are reference-counted and
+     * are copied on the first mutable access (`as_object_or_throw`, `getattr_or_throw` etc)
+     * to them from either value. Nodes, mutable references into which were handed out
+     * earlier, are copied (one level at a time) instead of sharing.
+     * Concurrent calls to this method for the same value are thread-safe.
+     * 
+     * @return copy of current instance
+     */
+    value clone_shared() const;
+
     /**
      * Returns type of this value
      * 
@@ -281,7 +413,8 @@ public:
      * Returns value of the field with specified name if this
      * value is an `OBJECT` and contains specified field.
      * Otherwise returns `NULL_T` value.
-     * Note: this is O(number_of_fields) operation, consider using explicit loop instead.
+     * Note: this is O(number_of_fields) operation for objects smaller than
+     * `set_object_index_threshold`, larger objects are looked up using hash index.
      * 
      * @return value of specified field
      */
@@ -291,7 +424,8 @@ public:
      * Returns value of the field with specified name if this
      * value is an `OBJECT` and contains specified field.
      * Otherwise returns `NULL_T` value.
-     * Note: this is O(number_of_fields) operation, consider using explicit loop instead.
+     * Note: this is O(number_of_fields) operation for objects smaller than
+     * `set_object_index_threshold`, larger objects are looked up using hash index.
      * 
      * @return value of specified field
      */
@@ -303,7 +437,8 @@ public:
      * If this value doesn't contain specified attribute - new attribute of type `NULL_T`
      * with the specified name will be created.
      * If this value is not an `OBJECT`: "json_exception" will be thrown.
-     * Note: this is O(number_of_fields) operation, consider using explicit loop instead.
+     * Note: this is O(number_of_fields) operation for objects smaller than
+     * `set_object_index_threshold`, larger objects are looked up using hash index.
      * 
      * @return value of specified field
      */
@@ -319,6 +454,9 @@ public:
     /**
      * Access value as a mutable `OBJECT`
      * If this value is not an `OBJECT`: "json_exception" will be thrown.
+     * Fields can be changed through the returned reference at any time, lookups
+     * by name in this object then fall back to the linear search when the field
+     * is not found in the hash index.
      * 
      * @return list of `name->value` pairs
      */
@@ -342,7 +480,8 @@ public:
     bool set_object(std::vector<field>&& object_value);
 
     /**
-     * Access value as an `ARRAY`     
+     * Access value as an `ARRAY`, packed array is expanded into values
+     * on the first call, packed numbers are kept along with the values
      * 
      * @return list of values
      */
@@ -373,6 +512,37 @@ public:
      */
     bool set_array(std::vector<value>&& array_value);
 
+    /**
+     * Checks whether this `ARRAY` value stores its numbers contiguously
+     * 
+     * @return `true` if array is packed
+     */
+    bool is_array_packed() const;
+
+    /**
+     * Returns the type of the elements of the packed `ARRAY`
+     * 
+     * @return `type::integer` or `type::real` for packed arrays,
+     *         `type::nullt` if this value is not a packed array
+     */
+    type packed_array_type() const;
+
+    /**
+     * Access packed `ARRAY` of integers without expanding it into values
+     * 
+     * @return array elements, empty span if this value is not a packed
+     *         array of integers
+     */
+    sl::io::span<const int64_t> as_int64_span() const;
+
+    /**
+     * Access packed `ARRAY` of real numbers without expanding it into values
+     * 
+     * @return array elements, empty span if this value is not a packed
+     *         array of real numbers
+     */
+    sl::io::span<const double> as_double_span() const;
+
     /**
      * Access value as an `STRING`
      * 
@@ -380,6 +550,20 @@ public:
      */
     const std::string& as_string() const;
 
+    /**
+     * Access value as an `STRING` without conversion of the borrowed data
+     * 
+     * @return string data, empty span if this value is not a `STRING`
+     */
+    sl::io::span<const char> as_string_span() const;
+
+    /**
+     * Checks whether this `STRING` value references external data
+     * 
+     * @return `true` if string data is borrowed
+     */
+    bool is_string_borrowed() const;
+
     /**
      * Access value as an `STRING`
      * If this value is not a `STRING`: "json_exception" will be thrown.
@@ -405,8 +589,8 @@ public:
     std::string& as_string_nonempty_or_throw(const std::string& context = "");
 
     /**
-     * Access value as an `STRING`
-     * If this value is not a `STRING`: "json_exception" will be thrown.
+     * Access value as non-empty `STRING`
+     * If this value is not a non-empty `STRING`: "json_exception" will be thrown.
      * 
      * @return string value
      */
@@ -770,6 +954,21 @@ public:
      */
     bool set_bool(bool bool_value);
 
+private:
+    void init_string(const char* data, size_t len);
+
+    const char* inline_string() const;
+
+    std::string* published_string() const;
+
+    const std::string& publish_string() const;
+
+    void own_string();
+
+    void release_node() STATICLIB_NOEXCEPT;
+
+    void unshare_node();
+
 };
 
 } // namespace
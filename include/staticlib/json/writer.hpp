@@ -0,0 +1,449 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   writer.hpp
+ * Author: alex
+ *
+ * Created on October 21, 2026, 2:40 PM
+ */
+
+#ifndef STATICLIB_JSON_WRITER_HPP
+#define STATICLIB_JSON_WRITER_HPP
+
+#include <cstring>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/dump_options.hpp"
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/value.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_writer {
+
+const size_t buffer_size = 4096;
+
+/**
+ * Output buffer of the streaming writers, is allocated once
+ * and is written to the destination streambuf when full or on `flush()`
+ */
+class output {
+    sl::io::streambuf_sink sink;
+    std::vector<char> buffer;
+    size_t filled = 0;
+
+public:
+    output(std::streambuf* dest) :
+    sink(dest),
+    buffer(buffer_size) { }
+
+    output(const output&) = delete;
+
+    output& operator=(const output&) = delete;
+
+    output(output&& other, std::streambuf* dest) :
+    sink(dest),
+    buffer(std::move(other.buffer)),
+    filled(other.filled) {
+        other.filled = 0;
+    }
+
+    output& operator=(output&& other) {
+        flush();
+        buffer = std::move(other.buffer);
+        filled = other.filled;
+        other.filled = 0;
+        return *this;
+    }
+
+    void write(const char* data, size_t len) {
+        if (filled + len > buffer.size()) {
+            flush();
+            if (len > buffer.size()) {
+                sl::io::write_all(sink, {data, len});
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + filled, data, len);
+        filled += len;
+    }
+
+    void put(char ch) {
+        if (filled < buffer.size()) {
+            buffer[filled] = ch;
+            filled += 1;
+        } else {
+            write(std::addressof(ch), 1);
+        }
+    }
+
+    void flush() {
+        if (filled > 0) {
+            sl::io::write_all(sink, {buffer.data(), filled});
+            filled = 0;
+        }
+    }
+};
+
+/**
+ * Writes escaped field name followed by the name separator
+ *
+ * @param out destination output
+ * @param name field name
+ * @param options serialization options
+ */
+void dump_key(output& out, const std::string& name, const dump_options& options);
+
+/**
+ * Writes the value that is nested into the specified number of
+ * open containers, nested lines are indented accordingly
+ *
+ * @param out destination output
+ * @param val value to write
+ * @param options serialization options
+ * @param depth nesting level of the value
+ * @throws json_exception if value cannot be serialized
+ */
+void dump_value(output& out, const value& val, const dump_options& options, size_t depth);
+
+} // namespace
+
+/**
+ * Streaming JSON writer, writes objects and arrays to the underlying
+ * sink element by element, containers can be nested and can be mixed with
+ * complete `json::value` instances. Only the stack of open containers is
+ * kept in memory, so large outputs (e.g. an object with a huge array of items)
+ * can be written without building the whole `json::value` tree.
+ * Output layout is the same as produced by `value::dump` with the same options,
+ * `sort_keys` option applies only to the values passed to `write`.
+ * Output is buffered, buffer is written to the sink when it is full, when
+ * the top-level value is complete, on `flush()` and on destruction.
+ *
+ * Calls sequence is checked, `json_exception` is thrown on misplaced calls
+ * (e.g. value inside object without a key or end of the container that is not open).
+ * Unfinished containers are NOT closed automatically.
+ */
+template<typename Sink>
+class writer {
+    class open_container {
+    public:
+        bool object;
+        bool has_entries;
+        bool has_key;
+
+        open_container(bool object) :
+        object(object),
+        has_entries(false),
+        has_key(false) { }
+    };
+
+    Sink sink;
+    sl::io::unbuffered_ostreambuf<sl::io::reference_sink<Sink>> sbuf;
+    detail_writer::output out;
+    dump_options options;
+    std::vector<open_container> stack;
+    bool top_level_written = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param sink destination sink
+     * @param options serialization options
+     */
+    writer(Sink&& sink, const dump_options& options = dump_options()) :
+    sink(std::move(sink)),
+    sbuf(sl::io::make_unbuffered_ostreambuf(this->sink)),
+    out(std::addressof(sbuf)),
+    options(options) { }
+
+    /**
+     * Destructor, writes buffered output to the sink
+     */
+    ~writer() STATICLIB_NOEXCEPT {
+        try {
+            out.flush();
+        } catch (...) {
+            // keep silent
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    writer(const writer&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    writer& operator=(const writer&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    writer(writer&& other) :
+    sink(std::move(other.sink)),
+    sbuf(sl::io::make_unbuffered_ostreambuf(this->sink)),
+    out(std::move(other.out), std::addressof(sbuf)),
+    options(other.options),
+    stack(std::move(other.stack)),
+    top_level_written(other.top_level_written) { }
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @returns this instance
+     */
+    writer& operator=(writer&& other) {
+        out.flush();
+        sink = std::move(other.sink);
+        out = std::move(other.out);
+        options = other.options;
+        stack = std::move(other.stack);
+        top_level_written = other.top_level_written;
+        return *this;
+    }
+
+    /**
+     * Writes opening bracket of the object
+     *
+     * @throws json_exception on misplaced call
+     */
+    void begin_object() {
+        start_entry("begin_object");
+        stack.emplace_back(true);
+        out.put('{');
+    }
+
+    /**
+     * Writes the name of the next field of the current object
+     *
+     * @param name field name
+     * @throws json_exception on misplaced call
+     */
+    void key(const std::string& name) {
+        if (stack.empty() || !stack.back().object || stack.back().has_key) {
+            throw json_exception(TRACEMSG("Invalid JSON writer call: 'key'," +
+                    " name: [" + name + "], key is not expected"));
+        }
+        open_container& oc = stack.back();
+        write_separator(oc);
+        oc.has_key = true;
+        detail_writer::dump_key(out, name, options);
+    }
+
+    /**
+     * Writes closing bracket of the current object
+     *
+     * @throws json_exception on misplaced call
+     */
+    void end_object() {
+        end_container(true, "end_object");
+        out.put('}');
+        finish_entry();
+    }
+
+    /**
+     * Writes opening bracket of the array
+     *
+     * @throws json_exception on misplaced call
+     */
+    void begin_array() {
+        start_entry("begin_array");
+        stack.emplace_back(false);
+        out.put('[');
+    }
+
+    /**
+     * Writes closing bracket of the current array
+     *
+     * @throws json_exception on misplaced call
+     */
+    void end_array() {
+        end_container(false, "end_array");
+        out.put(']');
+        finish_entry();
+    }
+
+    /**
+     * Writes the specified value, either as the next element of the
+     * current array, or as a value of the current object field, or as
+     * a top-level value
+     *
+     * @param val value to write, scalars are converted implicitly
+     * @throws json_exception on misplaced call or if value cannot be serialized
+     */
+    void write(const value& val) {
+        start_entry("write");
+        detail_writer::dump_value(out, val, options, stack.size());
+        finish_entry();
+    }
+
+    /**
+     * Writes the field with the specified name and value
+     * into the current object, same as `key` followed by `write`
+     *
+     * @param name field name
+     * @param val field value
+     * @throws json_exception on misplaced call or if value cannot be serialized
+     */
+    void write(const std::string& name, const value& val) {
+        key(name);
+        write(val);
+    }
+
+    /**
+     * Checks whether a complete top-level value was written
+     *
+     * @return true if top-level value is complete, false otherwise
+     */
+    bool is_complete() const {
+        return top_level_written && stack.empty();
+    }
+
+    /**
+     * Writes buffered output to the sink
+     */
+    void flush() {
+        out.flush();
+    }
+
+    /**
+     * Underlying sink accessor, buffered output that is not
+     * yet flushed is not available in the sink
+     *
+     * @return underlying sink
+     */
+    Sink& get_sink() {
+        return sink;
+    }
+
+private:
+    bool pretty() const {
+        return !options.compact && options.indent > 0;
+    }
+
+    void write_indent(size_t depth) {
+        static const char spaces[] = "                                ";
+        out.put('\n');
+        size_t count = depth * options.indent;
+        while (count > 0) {
+            size_t chunk = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+            out.write(spaces, chunk);
+            count -= chunk;
+        }
+    }
+
+    void write_separator(open_container& oc) {
+        if (oc.has_entries) {
+            out.put(',');
+            if (!pretty() && !options.compact) {
+                out.put(' ');
+            }
+        }
+        if (pretty()) {
+            write_indent(stack.size());
+        }
+        oc.has_entries = true;
+    }
+
+    void start_entry(const std::string& call) {
+        if (stack.empty()) {
+            if (top_level_written) {
+                throw json_exception(TRACEMSG("Invalid JSON writer call: '" + call + "'," +
+                        " top-level value is already written"));
+            }
+            top_level_written = true;
+            return;
+        }
+        open_container& oc = stack.back();
+        if (oc.object) {
+            if (!oc.has_key) {
+                throw json_exception(TRACEMSG("Invalid JSON writer call: '" + call + "'," +
+                        " field name must be written first"));
+            }
+            oc.has_key = false;
+        } else {
+            write_separator(oc);
+        }
+    }
+
+    void finish_entry() {
+        if (stack.empty()) {
+            out.flush();
+        }
+    }
+
+    void end_container(bool object, const std::string& call) {
+        if (stack.empty() || object != stack.back().object || stack.back().has_key) {
+            throw json_exception(TRACEMSG("Invalid JSON writer call: '" + call + "'," +
+                    " no matching container is open"));
+        }
+        bool has_entries = stack.back().has_entries;
+        stack.pop_back();
+        if (has_entries && pretty()) {
+            write_indent(stack.size());
+        }
+    }
+};
+
+/**
+ * Factory function for creating streaming writers,
+ * created writer will own specified sink
+ *
+ * @param sink destination sink
+ * @param options serialization options
+ * @return writer instance
+ */
+template <typename Sink,
+class = typename std::enable_if<!std::is_lvalue_reference<Sink>::value>::type>
+writer<Sink> make_writer(Sink&& sink, const dump_options& options = dump_options()) {
+    return writer<Sink>(std::move(sink), options);
+}
+
+/**
+ * Factory function for creating streaming writers,
+ * created writer will NOT own specified sink
+ *
+ * @param sink destination sink
+ * @param options serialization options
+ * @return writer instance
+ */
+template <typename Sink>
+writer<sl::io::reference_sink<Sink>> make_writer(Sink& sink, const dump_options& options = dump_options()) {
+    return writer<sl::io::reference_sink<Sink>> (sl::io::make_reference_sink(sink), options);
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_JSON_WRITER_HPP */
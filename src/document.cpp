@@ -0,0 +1,414 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   document.cpp
+ * Author: alex
+ *
+ * Created on October 20, 2026, 4:05 PM
+ */
+
+#include "staticlib/json/document.hpp"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include "staticlib/json/field.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace { // anonymous
+
+const uint64_t payload_mask = (static_cast<uint64_t> (1) << 56) - 1;
+const uint64_t count_max = 0xffffff;
+const uint64_t index_mask = 0xffffffff;
+const std::string empty_string{};
+
+uint64_t make_word(detail_document::tag tg, uint64_t payload) {
+    return (static_cast<uint64_t> (tg) << 56) | payload;
+}
+
+detail_document::tag word_tag(uint64_t word) {
+    return static_cast<detail_document::tag> (word >> 56);
+}
+
+uint64_t word_payload(uint64_t word) {
+    return word & payload_mask;
+}
+
+detail_document::builder build_tape(sl::io::span<const char> data) {
+    auto pr = parser<sl::io::span<const char>>(std::move(data));
+    auto bld = detail_document::builder();
+    pr.parse(bld);
+    return bld;
+}
+
+} // namespace
+
+namespace detail_document {
+
+void builder::start_object() {
+    start_container(tag::object);
+}
+
+void builder::key(const std::string& name) {
+    stack.back().count += 1;
+    add_string(tag::key, name);
+}
+
+void builder::end_object() {
+    end_container(tag::object);
+}
+
+void builder::start_array() {
+    start_container(tag::array);
+}
+
+void builder::end_array() {
+    end_container(tag::array);
+}
+
+void builder::string(const std::string& val) {
+    add_entry();
+    add_string(tag::string, val);
+}
+
+void builder::integer(int64_t val) {
+    add_entry();
+    tape.push_back(make_word(tag::integer, 0));
+    uint64_t bits;
+    std::memcpy(std::addressof(bits), std::addressof(val), sizeof(bits));
+    tape.push_back(bits);
+}
+
+void builder::real(double val) {
+    add_entry();
+    tape.push_back(make_word(tag::real, 0));
+    uint64_t bits;
+    std::memcpy(std::addressof(bits), std::addressof(val), sizeof(bits));
+    tape.push_back(bits);
+}
+
+void builder::boolean(bool val) {
+    add_entry();
+    tape.push_back(make_word(tag::boolean, val ? 1 : 0));
+}
+
+void builder::null() {
+    add_entry();
+    tape.push_back(make_word(tag::nullt, 0));
+}
+
+void builder::start_container(tag tg) {
+    add_entry();
+    stack.push_back({tape.size(), 0, tag::object == tg});
+    // patched when container is closed
+    tape.push_back(make_word(tg, 0));
+}
+
+void builder::end_container(tag tg) {
+    auto& oc = stack.back();
+    if (tape.size() > index_mask) {
+        throw json_exception(TRACEMSG("Document is too large, tape size: [" + sl::support::to_string(tape.size()) + "]"));
+    }
+    uint64_t count = oc.count < count_max ? oc.count : count_max;
+    tape[oc.idx] = make_word(tg, (count << 32) | tape.size());
+    stack.pop_back();
+}
+
+void builder::add_entry() {
+    // object entries are counted by keys
+    if (!stack.empty() && !stack.back().object) {
+        stack.back().count += 1;
+    }
+}
+
+void builder::add_string(tag tg, const std::string& str) {
+    if (str.length() > std::numeric_limits<uint32_t>::max()) {
+        throw json_exception(TRACEMSG("String is too large, length: [" + sl::support::to_string(str.length()) + "]"));
+    }
+    tape.push_back(make_word(tg, strings.length()));
+    uint32_t len = static_cast<uint32_t> (str.length());
+    strings.append(reinterpret_cast<const char*> (std::addressof(len)), sizeof(len));
+    strings.append(str);
+}
+
+} // namespace
+
+document_value::array_iterator& document_value::array_iterator::operator++() {
+    idx = doc->next_index(idx);
+    return *this;
+}
+
+document_field document_value::object_iterator::operator*() const {
+    return document_field(doc, idx);
+}
+
+document_value::object_iterator& document_value::object_iterator::operator++() {
+    // skip name and value
+    idx = doc->next_index(idx + 1);
+    return *this;
+}
+
+document_value::document_value() :
+doc(nullptr),
+idx(0) { }
+
+document_value::document_value(const document* doc, size_t idx) :
+doc(doc),
+idx(idx) { }
+
+type document_value::json_type() const {
+    if (nullptr == doc) {
+        return type::nullt;
+    }
+    switch (word_tag(doc->tape[idx])) {
+    case detail_document::tag::object: return type::object;
+    case detail_document::tag::array: return type::array;
+    case detail_document::tag::string: return type::string;
+    case detail_document::tag::integer: return type::integer;
+    case detail_document::tag::real: return type::real;
+    case detail_document::tag::boolean: return type::boolean;
+    default: return type::nullt;
+    }
+}
+
+document_value document_value::getattr(const std::string& name) const {
+    for (auto fi : as_object()) {
+        auto key = fi.name_span();
+        if (key.size() == name.length() && 0 == std::memcmp(key.data(), name.data(), key.size())) {
+            return fi.val();
+        }
+    }
+    return document_value();
+}
+
+document_value document_value::operator[](const std::string& name) const {
+    return getattr(name);
+}
+
+document_value document_value::at(size_t idx) const {
+    size_t count = 0;
+    for (auto el : as_array()) {
+        if (idx == count) {
+            return el;
+        }
+        count += 1;
+    }
+    return document_value();
+}
+
+size_t document_value::size() const {
+    type jt = json_type();
+    if (type::object != jt && type::array != jt) {
+        return 0;
+    }
+    uint64_t count = word_payload(doc->tape[idx]) >> 32;
+    if (count < count_max) {
+        return static_cast<size_t> (count);
+    }
+    // saturated, entries are counted
+    size_t res = 0;
+    if (type::object == jt) {
+        for (auto fi : as_object()) {
+            (void) fi;
+            res += 1;
+        }
+    } else {
+        for (auto el : as_array()) {
+            (void) el;
+            res += 1;
+        }
+    }
+    return res;
+}
+
+document_value::range<document_value::object_iterator> document_value::as_object() const {
+    if (type::object != json_type()) {
+        return range<object_iterator>(object_iterator(nullptr, 0), object_iterator(nullptr, 0));
+    }
+    size_t end = doc->next_index(idx);
+    return range<object_iterator>(object_iterator(doc, idx + 1), object_iterator(doc, end));
+}
+
+document_value::range<document_value::array_iterator> document_value::as_array() const {
+    if (type::array != json_type()) {
+        return range<array_iterator>(array_iterator(nullptr, 0), array_iterator(nullptr, 0));
+    }
+    size_t end = doc->next_index(idx);
+    return range<array_iterator>(array_iterator(doc, idx + 1), array_iterator(doc, end));
+}
+
+sl::io::span<const char> document_value::as_string_span() const {
+    if (type::string == json_type()) {
+        return doc->string_at(idx);
+    }
+    return sl::io::span<const char>(empty_string.data(), empty_string.length());
+}
+
+std::string document_value::as_string() const {
+    if (type::string == json_type()) {
+        auto span = doc->string_at(idx);
+        return std::string(span.data(), span.size());
+    }
+    return std::string();
+}
+
+std::string document_value::as_string_or_throw(const std::string& context) const {
+    if (type::string != json_type()) {
+        throw access_error("string", context);
+    }
+    return as_string();
+}
+
+int64_t document_value::as_int64() const {
+    if (type::integer == json_type()) {
+        int64_t res;
+        std::memcpy(std::addressof(res), std::addressof(doc->tape[idx + 1]), sizeof(res));
+        return res;
+    }
+    return 0;
+}
+
+int64_t document_value::as_int64_or_throw(const std::string& context) const {
+    if (type::integer != json_type()) {
+        throw access_error("int64", context);
+    }
+    return as_int64();
+}
+
+double document_value::as_double() const {
+    if (type::real == json_type()) {
+        double res;
+        std::memcpy(std::addressof(res), std::addressof(doc->tape[idx + 1]), sizeof(res));
+        return res;
+    }
+    return 0;
+}
+
+double document_value::as_double_or_throw(const std::string& context) const {
+    if (type::real != json_type()) {
+        throw access_error("double", context);
+    }
+    return as_double();
+}
+
+bool document_value::as_bool() const {
+    if (type::boolean == json_type()) {
+        return 1 == word_payload(doc->tape[idx]);
+    }
+    return false;
+}
+
+bool document_value::as_bool_or_throw(const std::string& context) const {
+    if (type::boolean != json_type()) {
+        throw access_error("boolean", context);
+    }
+    return as_bool();
+}
+
+value document_value::to_value() const {
+    switch (json_type()) {
+    case type::object: {
+        auto fields = std::vector<field>();
+        fields.reserve(size());
+        for (auto fi : as_object()) {
+            fields.emplace_back(fi.name(), fi.val().to_value());
+        }
+        return value(std::move(fields));
+    }
+    case type::array: {
+        auto values = std::vector<value>();
+        values.reserve(size());
+        for (auto el : as_array()) {
+            values.emplace_back(el.to_value());
+        }
+        return value(std::move(values));
+    }
+    case type::string: return value(as_string());
+    case type::integer: return value(as_int64());
+    case type::real: return value(as_double());
+    case type::boolean: return value(as_bool());
+    default: return value();
+    }
+}
+
+json_exception document_value::access_error(const std::string& target, const std::string& context) const {
+    return json_exception(TRACEMSG("Cannot access '" + target + "'" +
+            " from target value: [" + to_value().dumps() + "]," +
+            " context: [" + context + "]"));
+}
+
+std::string document_field::name() const {
+    auto span = name_span();
+    return std::string(span.data(), span.size());
+}
+
+sl::io::span<const char> document_field::name_span() const {
+    return doc->string_at(idx);
+}
+
+document_value document_field::val() const {
+    return document_value(doc, idx + 1);
+}
+
+document::document(sl::io::span<const char> data) :
+document(build_tape(data)) { }
+
+document::document(detail_document::builder&& bld) :
+tape(std::move(bld.tape)),
+strings(std::move(bld.strings)) {
+    tape.shrink_to_fit();
+    strings.shrink_to_fit();
+}
+
+document::document(document&& other) :
+tape(std::move(other.tape)),
+strings(std::move(other.strings)) { }
+
+document_value document::root() const {
+    return document_value(this, 0);
+}
+
+document_value document::operator[](const std::string& name) const {
+    return root().getattr(name);
+}
+
+size_t document::next_index(size_t idx) const {
+    uint64_t word = tape[idx];
+    switch (word_tag(word)) {
+    case detail_document::tag::object:
+    case detail_document::tag::array:
+        return static_cast<size_t> (word_payload(word) & index_mask);
+    case detail_document::tag::integer:
+    case detail_document::tag::real:
+        return idx + 2;
+    default:
+        return idx + 1;
+    }
+}
+
+sl::io::span<const char> document::string_at(size_t idx) const {
+    size_t offset = static_cast<size_t> (word_payload(tape[idx]));
+    uint32_t len;
+    std::memcpy(std::addressof(len), strings.data() + offset, sizeof(len));
+    return sl::io::span<const char>(strings.data() + offset + sizeof(len), len);
+}
+
+} // namespace
+}
@@ -0,0 +1,648 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dump_ops.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 2:37 PM
+ */
+
+#ifndef STATICLIB_JSON_DUMP_OPS_HPP
+#define STATICLIB_JSON_DUMP_OPS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/json/dump_options.hpp"
+#include "staticlib/json/field.hpp"
+#include "staticlib/json/json_exception.hpp"
+#include "staticlib/json/parser.hpp"
+#include "staticlib/json/value.hpp"
+
+#include "grisu_ops.hpp"
+#include "scan_ops.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace detail_dump {
+
+/**
+ * Size of the write buffer used with streambufs
+ */
+const size_t buffer_size = 4096;
+
+/**
+ * Properties of the output types
+ */
+template<typename Output>
+class output_traits {
+public:
+    // output only counts the bytes, data passed to it is ignored
+    static const bool counts_only = false;
+};
+
+/**
+ * Output that appends data to the specified string
+ */
+class string_output {
+    std::string& dest;
+
+public:
+    string_output(std::string& dest) :
+    dest(dest) { }
+
+    string_output(const string_output&) = delete;
+
+    string_output& operator=(const string_output&) = delete;
+
+    void write(const char* data, size_t len) {
+        dest.append(data, len);
+    }
+
+    void put(char ch) {
+        dest.push_back(ch);
+    }
+
+    void flush() { }
+};
+
+/**
+ * Output that only counts the number of bytes written
+ */
+class counting_output {
+    size_t count = 0;
+
+public:
+    counting_output() { }
+
+    counting_output(const counting_output&) = delete;
+
+    counting_output& operator=(const counting_output&) = delete;
+
+    void write(const char*, size_t len) {
+        count += len;
+    }
+
+    void put(char) {
+        count += 1;
+    }
+
+    void flush() { }
+
+    size_t size() const {
+        return count;
+    }
+};
+
+template<>
+class output_traits<counting_output> {
+public:
+    static const bool counts_only = true;
+};
+
+/**
+ * Output that writes data into the specified preallocated buffer,
+ * data that does not fit into buffer is counted but not written
+ */
+class span_output {
+    sl::io::span<char> dest;
+    size_t count = 0;
+
+public:
+    span_output(sl::io::span<char> dest) :
+    dest(dest) { }
+
+    span_output(const span_output&) = delete;
+
+    span_output& operator=(const span_output&) = delete;
+
+    void write(const char* data, size_t len) {
+        if (count < dest.size()) {
+            size_t avail = dest.size() - count;
+            std::memcpy(dest.data() + count, data, len < avail ? len : avail);
+        }
+        count += len;
+    }
+
+    void put(char ch) {
+        if (count < dest.size()) {
+            dest.data()[count] = ch;
+        }
+        count += 1;
+    }
+
+    void flush() { }
+
+    size_t size() const {
+        return count;
+    }
+};
+
+/**
+ * Buffered output over the specified streambuf
+ */
+class streambuf_output {
+    sl::io::streambuf_sink sink;
+    std::vector<char> buffer;
+    size_t filled = 0;
+
+public:
+    streambuf_output(std::streambuf* dest) :
+    sink(dest),
+    buffer(buffer_size) { }
+
+    streambuf_output(const streambuf_output&) = delete;
+
+    streambuf_output& operator=(const streambuf_output&) = delete;
+
+    void write(const char* data, size_t len) {
+        if (filled + len > buffer.size()) {
+            flush();
+            if (len > buffer.size()) {
+                sl::io::write_all(sink, {data, len});
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + filled, data, len);
+        filled += len;
+    }
+
+    void put(char ch) {
+        if (filled == buffer.size()) {
+            flush();
+        }
+        buffer[filled] = ch;
+        filled += 1;
+    }
+
+    void flush() {
+        if (filled > 0) {
+            sl::io::write_all(sink, {buffer.data(), filled});
+            filled = 0;
+        }
+    }
+};
+
+/**
+ * Formats integer into the specified buffer
+ *
+ * @param val integer value
+ * @param buf buffer of at least 21 bytes
+ * @return number of bytes written
+ */
+inline size_t format_integer(int64_t val, char* buf) {
+    static const char pairs[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char tmp[24];
+    size_t pos = sizeof(tmp);
+    // unsigned negation covers int64_t::min()
+    uint64_t num = val < 0 ? 0 - static_cast<uint64_t> (val) : static_cast<uint64_t> (val);
+    // two digits at a time
+    while (num >= 100) {
+        size_t idx = static_cast<size_t> (num % 100) * 2;
+        num /= 100;
+        tmp[--pos] = pairs[idx + 1];
+        tmp[--pos] = pairs[idx];
+    }
+    if (num >= 10) {
+        size_t idx = static_cast<size_t> (num) * 2;
+        tmp[--pos] = pairs[idx + 1];
+        tmp[--pos] = pairs[idx];
+    } else {
+        tmp[--pos] = static_cast<char> ('0' + num);
+    }
+    size_t res = 0;
+    if (val < 0) {
+        buf[res++] = '-';
+    }
+    std::memcpy(buf + res, tmp + pos, sizeof(tmp) - pos);
+    return res + sizeof(tmp) - pos;
+}
+
+/**
+ * Computes the length of the integer formatted with `format_integer`
+ *
+ * @param val integer value
+ * @return number of bytes
+ */
+inline size_t integer_length(int64_t val) {
+    uint64_t num = val < 0 ? 0 - static_cast<uint64_t> (val) : static_cast<uint64_t> (val);
+    size_t len = val < 0 ? 2 : 1;
+    uint64_t bound = 10;
+    // at most 19 digits, so the bound does not overflow
+    for (size_t digits = 1; digits < 19 && num >= bound; digits++) {
+        len += 1;
+        bound *= 10;
+    }
+    return len;
+}
+
+/**
+ * Formats real into the specified buffer using the shortest digits
+ * that are read back into the same value, notation is the same as
+ * used by Jansson ("%.17g" with mandatory dot or exponent)
+ *
+ * @param val finite real value
+ * @param buf buffer of at least 32 bytes
+ * @return number of bytes written
+ */
+inline size_t format_real(double val, char* buf) {
+    return detail_grisu::format_shortest(val, buf);
+}
+
+/**
+ * Formats real into the specified buffer rounding it to the specified
+ * number of significant digits, trailing zeroes are dropped,
+ * notation is the same as used by Jansson ("%.{precision}g"
+ * with mandatory dot or exponent)
+ *
+ * @param val finite real value
+ * @param precision number of significant digits, from 1 to 17
+ * @param buf buffer of at least 32 bytes
+ * @return number of bytes written
+ */
+inline size_t format_real(double val, size_t precision, char* buf) {
+    if (0 == val) {
+        return detail_grisu::format_shortest(val, buf);
+    }
+    bool negative = std::signbit(val);
+    char tmp[40];
+    int printed = std::snprintf(tmp, sizeof(tmp), "%.*e", static_cast<int> (precision - 1), negative ? -val : val);
+    if (printed < 0 || static_cast<size_t> (printed) >= sizeof(tmp)) {
+        throw json_exception(TRACEMSG("Error formatting real value: [" + sl::support::to_string(val) + "]"));
+    }
+    // only digits are taken, decimal point is locale-dependent
+    char digits[20];
+    int len = 0;
+    const char* pos = tmp;
+    for (; 'e' != *pos; pos++) {
+        if (*pos >= '0' && *pos <= '9') {
+            digits[len++] = *pos;
+        }
+    }
+    pos += 1;
+    bool exp_negative = '-' == *pos;
+    pos += 1;
+    int exp = 0;
+    for (; '\0' != *pos; pos++) {
+        exp = exp * 10 + (*pos - '0');
+    }
+    if (exp_negative) {
+        exp = -exp;
+    }
+    while (len > 1 && '0' == digits[len - 1]) {
+        len -= 1;
+    }
+    return detail_grisu::format_digits(negative, digits, len, exp - (len - 1), static_cast<int> (precision), buf);
+}
+
+/**
+ * JSON serializer that writes value directly to the specified output
+ */
+template<typename Output>
+class serializer {
+    Output& out;
+    const dump_options& options;
+    bool pretty;
+    size_t precision;
+
+public:
+    serializer(Output& out, const dump_options& options) :
+    out(out),
+    options(options),
+    pretty(!options.compact && options.indent > 0),
+    precision(options.real_precision < 17 ? options.real_precision : 17) { }
+
+    serializer(const serializer&) = delete;
+
+    serializer& operator=(const serializer&) = delete;
+
+    void dump(const value& val, size_t depth) {
+        switch (val.json_type()) {
+        case type::nullt: out.write("null", 4);
+            break;
+        case type::object: dump_object(val.as_object(), depth);
+            break;
+        case type::array:
+            // packed array is dumped without expanding it
+            switch (val.packed_array_type()) {
+            case type::integer: dump_packed(val.as_int64_span(), depth);
+                break;
+            case type::real: dump_packed(val.as_double_span(), depth);
+                break;
+            default: dump_array(val.as_array(), depth);
+            }
+            break;
+        case type::string: {
+            auto span = val.as_string_span();
+            dump_string(span.data(), span.size());
+            break;
+        }
+        case type::integer: dump_integer(val.as_int64());
+            break;
+        case type::real: dump_real(val.as_double());
+            break;
+        case type::boolean:
+            if (val.as_bool()) {
+                out.write("true", 4);
+            } else {
+                out.write("false", 5);
+            }
+            break;
+        default: throw json_exception(TRACEMSG(
+                    "Unsupported JSON type:[" + stringify_json_type(val.json_type()) + "]"));
+        }
+    }
+
+    void dump_key(const std::string& name) {
+        dump_string(name);
+        if (options.compact) {
+            out.put(':');
+        } else {
+            out.write(": ", 2);
+        }
+    }
+
+private:
+    void dump_indent(size_t depth) {
+        static const char spaces[] = "                                ";
+        if (!pretty) {
+            return;
+        }
+        out.put('\n');
+        size_t count = depth * options.indent;
+        while (count > 0) {
+            size_t chunk = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+            out.write(spaces, chunk);
+            count -= chunk;
+        }
+    }
+
+    void dump_separator(size_t depth) {
+        out.put(',');
+        if (pretty) {
+            dump_indent(depth);
+        } else if (!options.compact) {
+            out.put(' ');
+        }
+    }
+
+    void dump_object(const std::vector<field>& fields, size_t depth) {
+        out.put('{');
+        if (fields.empty()) {
+            out.put('}');
+            return;
+        }
+        // order of the keys does not change the size
+        bool sort = options.sort_keys && !output_traits<Output>::counts_only;
+        auto sorted = std::vector<const field*>();
+        if (sort) {
+            sorted.reserve(fields.size());
+            for (const field& fi : fields) {
+                sorted.push_back(std::addressof(fi));
+            }
+            std::sort(sorted.begin(), sorted.end(), [](const field* a, const field* b) {
+                return a->name() < b->name();
+            });
+        }
+        dump_indent(depth + 1);
+        for (size_t i = 0; i < fields.size(); i++) {
+            const field& fi = sort ? *sorted[i] : fields[i];
+            dump_key(fi.name());
+            dump(fi.val(), depth + 1);
+            if (i < fields.size() - 1) {
+                dump_separator(depth + 1);
+            } else {
+                dump_indent(depth);
+            }
+        }
+        out.put('}');
+    }
+
+    void dump_array(const std::vector<value>& values, size_t depth) {
+        out.put('[');
+        if (values.empty()) {
+            out.put(']');
+            return;
+        }
+        dump_indent(depth + 1);
+        for (size_t i = 0; i < values.size(); i++) {
+            dump(values[i], depth + 1);
+            if (i < values.size() - 1) {
+                dump_separator(depth + 1);
+            } else {
+                dump_indent(depth);
+            }
+        }
+        out.put(']');
+    }
+
+    template<typename T>
+    void dump_packed(sl::io::span<const T> numbers, size_t depth) {
+        out.put('[');
+        if (0 == numbers.size()) {
+            out.put(']');
+            return;
+        }
+        dump_indent(depth + 1);
+        for (size_t i = 0; i < numbers.size(); i++) {
+            dump_number(numbers[i]);
+            if (i < numbers.size() - 1) {
+                dump_separator(depth + 1);
+            } else {
+                dump_indent(depth);
+            }
+        }
+        out.put(']');
+    }
+
+    void dump_number(int64_t val) {
+        dump_integer(val);
+    }
+
+    void dump_number(double val) {
+        dump_real(val);
+    }
+
+    void dump_string(const std::string& str) {
+        dump_string(str.data(), str.length());
+    }
+
+    void dump_string(const char* str, size_t len) {
+        const char* end = str + len;
+        const char* invalid = detail_parser::find_utf8_invalid(str, end);
+        if (end != invalid) {
+            throw json_exception(TRACEMSG("Error dumping JSON string, invalid UTF-8," +
+                    " position: [" + sl::support::to_string(static_cast<size_t> (invalid - str)) + "]"));
+        }
+        out.put('"');
+        const char* run = str;
+        for (;;) {
+            // clean runs are copied in bulk
+            const char* cur = detail_parser::find_escape_special(run, end);
+            if (options.ensure_ascii) {
+                dump_ascii(run, cur);
+            } else if (cur > run) {
+                out.write(run, static_cast<size_t> (cur - run));
+            }
+            if (cur == end) {
+                break;
+            }
+            unsigned char ch = static_cast<unsigned char> (*cur);
+            switch (ch) {
+            case '"': out.write("\\\"", 2);
+                break;
+            case '\\': out.write("\\\\", 2);
+                break;
+            case '\b': out.write("\\b", 2);
+                break;
+            case '\f': out.write("\\f", 2);
+                break;
+            case '\n': out.write("\\n", 2);
+                break;
+            case '\r': out.write("\\r", 2);
+                break;
+            case '\t': out.write("\\t", 2);
+                break;
+            default: dump_codepoint(ch);
+            }
+            run = cur + 1;
+        }
+        out.put('"');
+    }
+
+    // writes valid UTF-8 escaping non-ASCII characters
+    void dump_ascii(const char* str, const char* end) {
+        const char* run = str;
+        const char* cur = str;
+        while (cur < end) {
+            unsigned char lead = static_cast<unsigned char> (*cur);
+            if (lead < 0x80) {
+                cur += 1;
+                continue;
+            }
+            if (cur > run) {
+                out.write(run, static_cast<size_t> (cur - run));
+            }
+            size_t len = lead >= 0xf0 ? 4 : lead >= 0xe0 ? 3 : 2;
+            if (output_traits<Output>::counts_only) {
+                // surrogate pair for 4-bytes sequences, single escape otherwise
+                out.write(nullptr, 4 == len ? 12 : 6);
+                cur += len;
+                run = cur;
+                continue;
+            }
+            uint32_t cp = lead & (0x3f >> (len - 1));
+            for (size_t i = 1; i < len; i++) {
+                cp = (cp << 6) | (static_cast<unsigned char> (cur[i]) & 0x3f);
+            }
+            if (cp >= 0x10000) {
+                cp -= 0x10000;
+                dump_codepoint(0xd800 + (cp >> 10));
+                dump_codepoint(0xdc00 + (cp & 0x3ff));
+            } else {
+                dump_codepoint(cp);
+            }
+            cur += len;
+            run = cur;
+        }
+        if (cur > run) {
+            out.write(run, static_cast<size_t> (cur - run));
+        }
+    }
+
+    void dump_codepoint(uint32_t cp) {
+        static const char* hex = "0123456789ABCDEF";
+        char seq[6] = {'\\', 'u', hex[(cp >> 12) & 0xf], hex[(cp >> 8) & 0xf], hex[(cp >> 4) & 0xf], hex[cp & 0xf]};
+        out.write(seq, 6);
+    }
+
+    void dump_integer(int64_t val) {
+        if (output_traits<Output>::counts_only) {
+            out.write(nullptr, integer_length(val));
+            return;
+        }
+        char buf[24];
+        size_t len = format_integer(val, buf);
+        out.write(buf, len);
+    }
+
+    void dump_real(double val) {
+        if (std::isnan(val) || std::isinf(val)) {
+            throw json_exception(TRACEMSG("Error dumping JSON, invalid real value: [" +
+                    sl::support::to_string(val) + "]"));
+        }
+        char buf[32];
+        size_t len = 0 == precision ? format_real(val, buf) : format_real(val, precision, buf);
+        out.write(buf, len);
+    }
+
+};
+
+} // namespace
+
+inline void dump_to_streambuf(const value& val, std::streambuf* dest, const dump_options& options) {
+    detail_dump::streambuf_output out(dest);
+    detail_dump::serializer<detail_dump::streambuf_output> ser(out, options);
+    ser.dump(val, 0);
+    out.flush();
+}
+
+inline size_t dump_to_span(const value& val, sl::io::span<char> dest, const dump_options& options) {
+    detail_dump::span_output out(dest);
+    detail_dump::serializer<detail_dump::span_output> ser(out, options);
+    ser.dump(val, 0);
+    return out.size();
+}
+
+inline size_t dump_size(const value& val, const dump_options& options) {
+    detail_dump::counting_output out;
+    detail_dump::serializer<detail_dump::counting_output> ser(out, options);
+    ser.dump(val, 0);
+    return out.size();
+}
+
+inline std::string dump_to_string(const value& val, const dump_options& options) {
+    std::string res;
+    // size pass does not format strings and integers,
+    // so it is cheaper than growing the string while dumping
+    res.reserve(dump_size(val, options));
+    detail_dump::string_output out(res);
+    detail_dump::serializer<detail_dump::string_output> ser(out, options);
+    ser.dump(val, 0);
+    return res;
+}
+
+}
+} // namespace
+
+#endif /* STATICLIB_JSON_DUMP_OPS_HPP */
@@ -23,31 +23,61 @@
 
 #include "staticlib/json/field.hpp"
 
+#include <memory>
+#include <new>
+
+#include "staticlib/json/key_pool.hpp"
+
 namespace staticlib {
 namespace json {
 
+field::~field() STATICLIB_NOEXCEPT {
+    release_name();
+}
+
 field::field(field&& other) STATICLIB_NOEXCEPT :
-field_name(std::move(other.field_name)),
-field_value(std::move(other.field_value)) { }
+field_value(std::move(other.field_value)) {
+    move_name(other);
+}
 
 field& field::operator=(field&& other) STATICLIB_NOEXCEPT {
-    field_name = std::move(other.field_name);
-    field_value = std::move(other.field_value);
+    if (this != std::addressof(other)) {
+        release_name();
+        move_name(other);
+        field_value = std::move(other.field_value);
+    }
     return *this;
 }
 
-field::field() { }
+field::field() {
+    new (owned_name) std::string();
+}
 
 field::field(std::string name, value json_value) :
-field_name(std::move(name)),
-field_value(std::move(json_value)) { }
+field_value(std::move(json_value)) {
+    new (owned_name) std::string(std::move(name));
+}
 
 field::field(const char* name, value json_value) :
-field_name(name),
-field_value(std::move(json_value)) { }
+field_value(std::move(json_value)) {
+    new (owned_name) std::string(name);
+}
+
+field::field(detail_key_pool::key_node* name_node, value json_value) :
+name_interned(true),
+field_value(std::move(json_value)) {
+    this->interned_name = name_node;
+}
 
 const std::string& field::name() const {
-    return field_name;
+    if (name_interned) {
+        return interned_name->str;
+    }
+    return *reinterpret_cast<const std::string*> (owned_name);
+}
+
+bool field::is_name_interned() const {
+    return name_interned;
 }
 
 type field::json_type() const {
@@ -68,7 +98,22 @@ void field::set_value(value&& json_value) {
 }
 
 field field::clone() const {
-    return field(field_name, field_value.clone());
+    value copy = field_value.clone();
+    if (name_interned) {
+        // interned names are immutable and are shared with clones
+        interned_name->add_ref();
+        return field(interned_name, std::move(copy));
+    }
+    return field(name(), std::move(copy));
+}
+
+field field::clone_shared() const {
+    value copy = field_value.clone_shared();
+    if (name_interned) {
+        interned_name->add_ref();
+        return field(interned_name, std::move(copy));
+    }
+    return field(name(), std::move(copy));
 }
 
 const std::vector<field>& field::as_object() const {
@@ -239,6 +284,34 @@ bool field::as_bool(bool default_val) const {
     return val().as_bool(default_val);
 }
 
+std::string& field::owned_name_str() {
+    static_assert(sizeof(owned_name) == sizeof(std::string) &&
+            alignof(detail_key_pool::key_node*) >= alignof(std::string),
+            "Invalid name storage");
+    return *reinterpret_cast<std::string*> (owned_name);
+}
+
+void field::release_name() STATICLIB_NOEXCEPT {
+    if (name_interned) {
+        interned_name->release();
+    } else {
+        owned_name_str().~basic_string();
+    }
+}
+
+void field::move_name(field& other) STATICLIB_NOEXCEPT {
+    if (other.name_interned) {
+        this->interned_name = other.interned_name;
+        this->name_interned = true;
+        // moved from field has an empty owned name
+        new (other.owned_name) std::string();
+        other.name_interned = false;
+    } else {
+        new (this->owned_name) std::string(std::move(other.owned_name_str()));
+        this->name_interned = false;
+    }
+}
+
 } // namespace
 } 
 
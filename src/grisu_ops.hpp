@@ -0,0 +1,414 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   grisu_ops.hpp
+ * Author: alex
+ *
+ * Created on October 21, 2026, 10:15 AM
+ */
+
+#ifndef STATICLIB_JSON_GRISU_OPS_HPP
+#define STATICLIB_JSON_GRISU_OPS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace staticlib {
+namespace json {
+
+/**
+ * Shortest round-trip formatting of doubles using Grisu2 algorithm
+ * (Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers", PLDI 2010). Produces the digits that are read back into
+ * the same double, the shortest such digits are produced for almost all inputs.
+ */
+namespace detail_grisu {
+
+/**
+ * Floating point number `f * 2^e` with 64-bit significand
+ */
+class diy_fp {
+public:
+    uint64_t f;
+    int e;
+
+    diy_fp(uint64_t f, int e) :
+    f(f),
+    e(e) { }
+
+    diy_fp sub(const diy_fp& other) const {
+        return diy_fp(f - other.f, e);
+    }
+
+    // upper 64 bits of the product, rounded
+    diy_fp mul(const diy_fp& other) const {
+        const uint64_t mask = 0xffffffff;
+        uint64_t a = f >> 32;
+        uint64_t b = f & mask;
+        uint64_t c = other.f >> 32;
+        uint64_t d = other.f & mask;
+        uint64_t ac = a * c;
+        uint64_t bc = b * c;
+        uint64_t ad = a * d;
+        uint64_t bd = b * d;
+        uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask);
+        tmp += static_cast<uint64_t> (1) << 31;
+        return diy_fp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + other.e + 64);
+    }
+
+    diy_fp normalize() const {
+        diy_fp res = *this;
+        while (0 == (res.f >> 63)) {
+            res.f <<= 1;
+            res.e -= 1;
+        }
+        return res;
+    }
+
+    diy_fp normalize_to(int exp) const {
+        return diy_fp(f << (e - exp), exp);
+    }
+};
+
+/**
+ * Normalized approximation of `10^k`
+ */
+class cached_power {
+public:
+    uint64_t f;
+    int e;
+    int k;
+};
+
+// products with cached powers are kept in [2^-60, 2^-32) range
+const int grisu_alpha = -60;
+const int cached_powers_min_dec_exp = -300;
+const int cached_powers_dec_step = 8;
+
+/**
+ * Finds cached power `c` such that `-60 <= c.e + e + 64 <= -32`
+ *
+ * @param e binary exponent of the normalized number
+ * @return cached power
+ */
+inline cached_power cached_power_for(int e) {
+    static const cached_power powers[] = {
+        {0xAB70FE17C79AC6CA, -1060, -300},
+        {0xFF77B1FCBEBCDC4F, -1034, -292},
+        {0xBE5691EF416BD60C, -1007, -284},
+        {0x8DD01FAD907FFC3C, -980, -276},
+        {0xD3515C2831559A83, -954, -268},
+        {0x9D71AC8FADA6C9B5, -927, -260},
+        {0xEA9C227723EE8BCB, -901, -252},
+        {0xAECC49914078536D, -874, -244},
+        {0x823C12795DB6CE57, -847, -236},
+        {0xC21094364DFB5637, -821, -228},
+        {0x9096EA6F3848984F, -794, -220},
+        {0xD77485CB25823AC7, -768, -212},
+        {0xA086CFCD97BF97F4, -741, -204},
+        {0xEF340A98172AACE5, -715, -196},
+        {0xB23867FB2A35B28E, -688, -188},
+        {0x84C8D4DFD2C63F3B, -661, -180},
+        {0xC5DD44271AD3CDBA, -635, -172},
+        {0x936B9FCEBB25C996, -608, -164},
+        {0xDBAC6C247D62A584, -582, -156},
+        {0xA3AB66580D5FDAF6, -555, -148},
+        {0xF3E2F893DEC3F126, -529, -140},
+        {0xB5B5ADA8AAFF80B8, -502, -132},
+        {0x87625F056C7C4A8B, -475, -124},
+        {0xC9BCFF6034C13053, -449, -116},
+        {0x964E858C91BA2655, -422, -108},
+        {0xDFF9772470297EBD, -396, -100},
+        {0xA6DFBD9FB8E5B88F, -369, -92},
+        {0xF8A95FCF88747D94, -343, -84},
+        {0xB94470938FA89BCF, -316, -76},
+        {0x8A08F0F8BF0F156B, -289, -68},
+        {0xCDB02555653131B6, -263, -60},
+        {0x993FE2C6D07B7FAC, -236, -52},
+        {0xE45C10C42A2B3B06, -210, -44},
+        {0xAA242499697392D3, -183, -36},
+        {0xFD87B5F28300CA0E, -157, -28},
+        {0xBCE5086492111AEB, -130, -20},
+        {0x8CBCCC096F5088CC, -103, -12},
+        {0xD1B71758E219652C, -77, -4},
+        {0x9C40000000000000, -50, 4},
+        {0xE8D4A51000000000, -24, 12},
+        {0xAD78EBC5AC620000, 3, 20},
+        {0x813F3978F8940984, 30, 28},
+        {0xC097CE7BC90715B3, 56, 36},
+        {0x8F7E32CE7BEA5C70, 83, 44},
+        {0xD5D238A4ABE98068, 109, 52},
+        {0x9F4F2726179A2245, 136, 60},
+        {0xED63A231D4C4FB27, 162, 68},
+        {0xB0DE65388CC8ADA8, 189, 76},
+        {0x83C7088E1AAB65DB, 216, 84},
+        {0xC45D1DF942711D9A, 242, 92},
+        {0x924D692CA61BE758, 269, 100},
+        {0xDA01EE641A708DEA, 295, 108},
+        {0xA26DA3999AEF774A, 322, 116},
+        {0xF209787BB47D6B85, 348, 124},
+        {0xB454E4A179DD1877, 375, 132},
+        {0x865B86925B9BC5C2, 402, 140},
+        {0xC83553C5C8965D3D, 428, 148},
+        {0x952AB45CFA97A0B3, 455, 156},
+        {0xDE469FBD99A05FE3, 481, 164},
+        {0xA59BC234DB398C25, 508, 172},
+        {0xF6C69A72A3989F5C, 534, 180},
+        {0xB7DCBF5354E9BECE, 561, 188},
+        {0x88FCF317F22241E2, 588, 196},
+        {0xCC20CE9BD35C78A5, 614, 204},
+        {0x98165AF37B2153DF, 641, 212},
+        {0xE2A0B5DC971F303A, 667, 220},
+        {0xA8D9D1535CE3B396, 694, 228},
+        {0xFB9B7CD9A4A7443C, 720, 236},
+        {0xBB764C4CA7A44410, 747, 244},
+        {0x8BAB8EEFB6409C1A, 774, 252},
+        {0xD01FEF10A657842C, 800, 260},
+        {0x9B10A4E5E9913129, 827, 268},
+        {0xE7109BFBA19C0C9D, 853, 276},
+        {0xAC2820D9623BF429, 880, 284},
+        {0x80444B5E7AA7CF85, 907, 292},
+        {0xBF21E44003ACDD2D, 933, 300},
+        {0x8E679C2F5E44FF8F, 960, 308},
+        {0xD433179D9C8CB841, 986, 316},
+        {0x9E19DB92B4E31BA9, 1013, 324}
+    };
+    // k = ceil((alpha - e - 1) * log10(2)), division truncates towards zero
+    int f = grisu_alpha - e - 1;
+    int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    int idx = (k - cached_powers_min_dec_exp + cached_powers_dec_step - 1) / cached_powers_dec_step;
+    return powers[idx];
+}
+
+/**
+ * Number of decimal digits in the specified number
+ *
+ * @param num number
+ * @param pow10 largest power of 10 not greater than number
+ * @return number of digits
+ */
+inline int count_digits(uint32_t num, uint32_t& pow10) {
+    int res = 1;
+    pow10 = 1;
+    while (num / pow10 >= 10) {
+        pow10 *= 10;
+        res += 1;
+    }
+    return res;
+}
+
+/**
+ * Moves last generated digit closer to the exact value
+ */
+inline void round_weed(char* buf, int len, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k) {
+    while (rest < dist && delta - rest >= ten_k &&
+            (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+        buf[len - 1] -= 1;
+        rest += ten_k;
+    }
+}
+
+/**
+ * Generates digits of the number in (minus, plus) range that is closest to `w`
+ */
+inline void generate_digits(char* buf, int& len, int& dec_exp, diy_fp minus, diy_fp w, diy_fp plus) {
+    uint64_t delta = plus.sub(minus).f;
+    uint64_t dist = plus.sub(w).f;
+    const int shift = -plus.e;
+    const uint64_t one = static_cast<uint64_t> (1) << shift;
+    // integral part fits into 32 bits because of gamma
+    uint32_t p1 = static_cast<uint32_t> (plus.f >> shift);
+    uint64_t p2 = plus.f & (one - 1);
+    uint32_t pow10;
+    int n = count_digits(p1, pow10);
+    while (n > 0) {
+        buf[len++] = static_cast<char> ('0' + p1 / pow10);
+        p1 %= pow10;
+        n -= 1;
+        uint64_t rest = (static_cast<uint64_t> (p1) << shift) + p2;
+        if (rest <= delta) {
+            dec_exp += n;
+            round_weed(buf, len, dist, delta, rest, static_cast<uint64_t> (pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+    int m = 0;
+    for (;;) {
+        p2 *= 10;
+        buf[len++] = static_cast<char> ('0' + (p2 >> shift));
+        p2 &= one - 1;
+        m += 1;
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) {
+            break;
+        }
+    }
+    dec_exp -= m;
+    round_weed(buf, len, dist, delta, p2, one);
+}
+
+/**
+ * Generates shortest digits for the positive finite number,
+ * number is equal to `digits * 10^dec_exp`
+ *
+ * @param val positive finite number
+ * @param buf buffer of at least 17 bytes
+ * @param len number of digits written
+ * @param dec_exp decimal exponent
+ */
+inline void grisu2(double val, char* buf, int& len, int& dec_exp) {
+    const uint64_t hidden_bit = static_cast<uint64_t> (1) << 52;
+    const int exp_bias = 1075;
+    uint64_t bits;
+    std::memcpy(std::addressof(bits), std::addressof(val), sizeof(bits));
+    uint64_t fraction = bits & (hidden_bit - 1);
+    int biased_exp = static_cast<int> (bits >> 52);
+    diy_fp v = 0 == biased_exp ? diy_fp(fraction, 1 - exp_bias) :
+            diy_fp(fraction + hidden_bit, biased_exp - exp_bias);
+    // boundaries are the halfway points to the neighbours,
+    // lower one is closer for powers of two
+    diy_fp plus = diy_fp((v.f << 1) + 1, v.e - 1).normalize();
+    diy_fp minus = (0 == fraction && biased_exp > 1) ?
+            diy_fp((v.f << 2) - 1, v.e - 2) : diy_fp((v.f << 1) - 1, v.e - 1);
+    minus = minus.normalize_to(plus.e);
+    diy_fp w = v.normalize();
+    cached_power cp = cached_power_for(plus.e);
+    diy_fp c = diy_fp(cp.f, cp.e);
+    diy_fp w_scaled = w.mul(c);
+    diy_fp minus_scaled = minus.mul(c);
+    diy_fp plus_scaled = plus.mul(c);
+    // unsafe interval is narrowed by 1 ulp on both sides for the errors of mul
+    minus_scaled.f += 1;
+    plus_scaled.f -= 1;
+    len = 0;
+    dec_exp = -cp.k;
+    generate_digits(buf, len, dec_exp, minus_scaled, w_scaled, plus_scaled);
+}
+
+/**
+ * Writes decimal exponent without '+' sign and leading zeroes
+ */
+inline size_t write_exponent(int exp, char* buf) {
+    size_t res = 0;
+    buf[res++] = 'e';
+    if (exp < 0) {
+        buf[res++] = '-';
+        exp = -exp;
+    }
+    if (exp >= 100) {
+        buf[res++] = static_cast<char> ('0' + exp / 100);
+        exp %= 100;
+        buf[res++] = static_cast<char> ('0' + exp / 10);
+    } else if (exp >= 10) {
+        buf[res++] = static_cast<char> ('0' + exp / 10);
+    }
+    buf[res++] = static_cast<char> ('0' + exp % 10);
+    return res;
+}
+
+/**
+ * Writes decimal digits using the same notation as "%.{max_exp}g",
+ * adds ".0" to integral numbers in fixed notation
+ *
+ * @param negative whether minus sign must be written
+ * @param digits significant digits without trailing zeroes
+ * @param len number of digits
+ * @param dec_exp decimal exponent of the last digit
+ * @param max_exp exponent of the first digit starting from which
+ *        exponent notation is used
+ * @param buf buffer of at least 32 bytes
+ * @return number of bytes written
+ */
+inline size_t format_digits(bool negative, const char* digits, int len, int dec_exp, int max_exp, char* buf) {
+    size_t res = 0;
+    if (negative) {
+        buf[res++] = '-';
+    }
+    // exponent of the first digit
+    int point = len + dec_exp;
+    int exp = point - 1;
+    if (exp < -4 || exp >= max_exp) {
+        buf[res++] = digits[0];
+        if (len > 1) {
+            buf[res++] = '.';
+            std::memcpy(buf + res, digits + 1, static_cast<size_t> (len - 1));
+            res += static_cast<size_t> (len - 1);
+        }
+        return res + write_exponent(exp, buf + res);
+    }
+    if (point <= 0) {
+        // 0.000ddd
+        buf[res++] = '0';
+        buf[res++] = '.';
+        std::memset(buf + res, '0', static_cast<size_t> (-point));
+        res += static_cast<size_t> (-point);
+        std::memcpy(buf + res, digits, static_cast<size_t> (len));
+        return res + static_cast<size_t> (len);
+    }
+    if (point >= len) {
+        // ddd000.0
+        std::memcpy(buf + res, digits, static_cast<size_t> (len));
+        res += static_cast<size_t> (len);
+        std::memset(buf + res, '0', static_cast<size_t> (point - len));
+        res += static_cast<size_t> (point - len);
+        std::memcpy(buf + res, ".0", 2);
+        return res + 2;
+    }
+    // ddd.ddd
+    std::memcpy(buf + res, digits, static_cast<size_t> (point));
+    res += static_cast<size_t> (point);
+    buf[res++] = '.';
+    std::memcpy(buf + res, digits + point, static_cast<size_t> (len - point));
+    return res + static_cast<size_t> (len - point);
+}
+
+/**
+ * Formats finite number using the same notation as "%.17g" with
+ * the shortest round-trip digits, adds ".0" to integral numbers
+ * in fixed notation
+ *
+ * @param val finite number
+ * @param buf buffer of at least 32 bytes
+ * @return number of bytes written
+ */
+inline size_t format_shortest(double val, char* buf) {
+    bool negative = std::signbit(val);
+    if (0 == val) {
+        size_t res = 0;
+        if (negative) {
+            buf[res++] = '-';
+        }
+        std::memcpy(buf + res, "0.0", 3);
+        return res + 3;
+    }
+    char digits[20];
+    int len = 0;
+    int dec_exp = 0;
+    grisu2(negative ? -val : val, digits, len, dec_exp);
+    return format_digits(negative, digits, len, dec_exp, 17, buf);
+}
+
+} // namespace
+
+}
+} // namespace
+
+#endif /* STATICLIB_JSON_GRISU_OPS_HPP */
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   key_pool.cpp
+ * Author: alex
+ *
+ * Created on October 20, 2026, 11:40 AM
+ */
+
+#include "staticlib/json/key_pool.hpp"
+
+#include <memory>
+
+namespace staticlib {
+namespace json {
+
+key_pool::~key_pool() STATICLIB_NOEXCEPT {
+    for (auto& en : keys) {
+        en.second->release();
+    }
+}
+
+key_pool::key_pool(key_pool&& other) :
+keys(std::move(other.keys)) {
+    other.keys.clear();
+}
+
+const std::string& key_pool::intern(const std::string& name) {
+    return find_or_add(name)->str;
+}
+
+field key_pool::make_field(const std::string& name, value json_value) {
+    auto node = find_or_add(name);
+    node->add_ref();
+    return field(node, std::move(json_value));
+}
+
+detail_key_pool::key_node* key_pool::find_or_add(const std::string& name) {
+    auto it = keys.find(std::addressof(name));
+    if (keys.end() != it) {
+        return it->second;
+    }
+    auto node = new detail_key_pool::key_node(name);
+    try {
+        keys.emplace(std::addressof(node->str), node);
+    } catch (...) {
+        node->release();
+        throw;
+    }
+    return node;
+}
+
+} // namespace
+}
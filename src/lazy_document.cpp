@@ -0,0 +1,447 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   lazy_document.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 10:48 AM
+ */
+
+#include "staticlib/json/lazy_document.hpp"
+
+#include <cstring>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/json/parser.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace { // anonymous
+
+json_exception make_error(const std::string& text, size_t position) {
+    return json_exception(TRACEMSG("Error parsing JSON:" +
+            " text: [" + text + "]" +
+            " position: [" + sl::support::to_string(position) + "]"));
+}
+
+bool is_whitespace(char ch) {
+    return ' ' == ch || '\n' == ch || '\t' == ch || '\r' == ch;
+}
+
+// returns offset of the byte after the closing quote
+size_t skip_string(const char* data, size_t len, size_t pos) {
+    size_t start = pos;
+    pos += 1;
+    while (pos < len) {
+        pos = static_cast<size_t> (detail_parser::find_string_special(data + pos, data + len) - data);
+        if (pos == len) {
+            break;
+        }
+        char ch = data[pos];
+        if ('"' == ch) {
+            return pos + 1;
+        }
+        pos += '\\' == ch ? 2 : 1;
+    }
+    throw make_error("premature end of input in string", start);
+}
+
+// moves over the input data using extents,
+// pos and ordinal are always updated together
+class walker {
+    const char* data;
+    size_t len;
+    const std::vector<detail_lazy::extent>& extents;
+
+public:
+    size_t pos;
+    size_t ordinal;
+
+    walker(const char* data, size_t len, const std::vector<detail_lazy::extent>& extents,
+            size_t pos, size_t ordinal) :
+    data(data),
+    len(len),
+    extents(extents),
+    pos(pos),
+    ordinal(ordinal) { }
+
+    int current() {
+        while (pos < len && is_whitespace(data[pos])) {
+            pos += 1;
+        }
+        return pos < len ? static_cast<unsigned char> (data[pos]) : -1;
+    }
+
+    void expect(char ch) {
+        if (ch != current()) {
+            throw make_error(std::string("'") + ch + "' expected", pos);
+        }
+        pos += 1;
+    }
+
+    // moves to the next entry, returns false at the end of container
+    bool next_entry(bool first, char close) {
+        int ch = current();
+        if (close == ch) {
+            return false;
+        }
+        if (!first) {
+            if (',' != ch) {
+                throw make_error(std::string("'") + close + "' expected", pos);
+            }
+            pos += 1;
+            current();
+        }
+        return true;
+    }
+
+    // returns offset of the key without quotes, leaves pos at value
+    size_t read_key(size_t& key_len) {
+        if ('"' != current()) {
+            throw make_error("string expected", pos);
+        }
+        size_t start = pos + 1;
+        pos = skip_string(data, len, pos);
+        key_len = pos - start - 1;
+        expect(':');
+        current();
+        return start;
+    }
+
+    void skip_value() {
+        int ch = current();
+        switch (ch) {
+        case '{':
+        case '[': {
+            auto& ext = extents[ordinal];
+            pos = ext.end;
+            ordinal = ext.next;
+            break;
+        }
+        case '"':
+            pos = skip_string(data, len, pos);
+            break;
+        default: {
+            size_t start = pos;
+            while (pos < len && !is_whitespace(data[pos]) &&
+                    ',' != data[pos] && '}' != data[pos] && ']' != data[pos]) {
+                pos += 1;
+            }
+            if (start == pos) {
+                throw make_error("value expected", pos);
+            }
+        }
+        }
+    }
+};
+
+bool key_equals(const char* key, size_t key_len, const std::string& name) {
+    if (nullptr == std::memchr(key, '\\', key_len)) {
+        return key_len == name.length() && 0 == std::memcmp(key, name.data(), key_len);
+    }
+    // escaped key, can be longer than decoded name
+    auto pr = parser<sl::io::span<const char>>({key - 1, key_len + 2});
+    std::string decoded;
+    pr.peek();
+    pr.read_string(decoded);
+    return name == decoded;
+}
+
+} // namespace
+
+lazy_value::lazy_value() :
+doc(nullptr),
+offset(0),
+ordinal(0) { }
+
+lazy_value::lazy_value(const lazy_document* doc, size_t offset, size_t ordinal) :
+doc(doc),
+offset(offset),
+ordinal(ordinal) { }
+
+type lazy_value::json_type() const {
+    if (nullptr == doc) {
+        return type::nullt;
+    }
+    const char* data = doc->data.data();
+    size_t len = doc->data.size();
+    char ch = data[offset];
+    switch (ch) {
+    case '{': return type::object;
+    case '[': return type::array;
+    case '"': return type::string;
+    case 't': case 'f': return type::boolean;
+    case 'n': return type::nullt;
+    case '-': case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        for (size_t i = offset + 1; i < len; i++) {
+            char nch = data[i];
+            if ('.' == nch || 'e' == nch || 'E' == nch) {
+                return type::real;
+            }
+            if (!(nch >= '0' && nch <= '9')) {
+                break;
+            }
+        }
+        return type::integer;
+    default: throw make_error("invalid token", offset);
+    }
+}
+
+lazy_value lazy_value::getattr(const std::string& name) const {
+    if (type::object != json_type()) {
+        return lazy_value();
+    }
+    auto wr = walker(doc->data.data(), doc->data.size(), doc->extents, offset + 1, ordinal + 1);
+    for (bool first = true; wr.next_entry(first, '}'); first = false) {
+        size_t key_len = 0;
+        size_t key = wr.read_key(key_len);
+        if (key_equals(doc->data.data() + key, key_len, name)) {
+            return lazy_value(doc, wr.pos, wr.ordinal);
+        }
+        wr.skip_value();
+    }
+    return lazy_value();
+}
+
+lazy_value lazy_value::operator[](const std::string& name) const {
+    return getattr(name);
+}
+
+lazy_value lazy_value::at(size_t idx) const {
+    if (type::array != json_type()) {
+        return lazy_value();
+    }
+    auto wr = walker(doc->data.data(), doc->data.size(), doc->extents, offset + 1, ordinal + 1);
+    size_t count = 0;
+    for (bool first = true; wr.next_entry(first, ']'); first = false) {
+        if (idx == count) {
+            return lazy_value(doc, wr.pos, wr.ordinal);
+        }
+        wr.skip_value();
+        count += 1;
+    }
+    return lazy_value();
+}
+
+size_t lazy_value::size() const {
+    type jt = json_type();
+    if (type::object != jt && type::array != jt) {
+        return 0;
+    }
+    bool obj = type::object == jt;
+    auto wr = walker(doc->data.data(), doc->data.size(), doc->extents, offset + 1, ordinal + 1);
+    size_t count = 0;
+    for (bool first = true; wr.next_entry(first, obj ? '}' : ']'); first = false) {
+        if (obj) {
+            size_t key_len = 0;
+            wr.read_key(key_len);
+        }
+        wr.skip_value();
+        count += 1;
+    }
+    return count;
+}
+
+std::vector<std::string> lazy_value::keys() const {
+    auto res = std::vector<std::string>();
+    if (type::object != json_type()) {
+        return res;
+    }
+    auto wr = walker(doc->data.data(), doc->data.size(), doc->extents, offset + 1, ordinal + 1);
+    for (bool first = true; wr.next_entry(first, '}'); first = false) {
+        size_t key_len = 0;
+        size_t key = wr.read_key(key_len);
+        auto pr = parser<sl::io::span<const char>>({doc->data.data() + key - 1, key_len + 2});
+        std::string name;
+        pr.peek();
+        pr.read_string(name);
+        res.emplace_back(std::move(name));
+        wr.skip_value();
+    }
+    return res;
+}
+
+std::string lazy_value::as_string() const {
+    std::string res;
+    if (type::string == json_type()) {
+        auto pr = parser<sl::io::span<const char>>(tail());
+        pr.peek();
+        pr.read_string(res);
+    }
+    return res;
+}
+
+std::string lazy_value::as_string_or_throw(const std::string& context) const {
+    if (type::string != json_type()) {
+        throw access_error("string", context);
+    }
+    return as_string();
+}
+
+int64_t lazy_value::as_int64() const {
+    if (type::integer == json_type()) {
+        auto pr = parser<sl::io::span<const char>>(tail());
+        pr.peek();
+        int64_t integer = 0;
+        double real = 0;
+        pr.read_number(integer, real);
+        return integer;
+    }
+    return 0;
+}
+
+int64_t lazy_value::as_int64_or_throw(const std::string& context) const {
+    if (type::integer != json_type()) {
+        throw access_error("int64", context);
+    }
+    return as_int64();
+}
+
+double lazy_value::as_double() const {
+    if (type::real == json_type()) {
+        auto pr = parser<sl::io::span<const char>>(tail());
+        pr.peek();
+        int64_t integer = 0;
+        double real = 0;
+        pr.read_number(integer, real);
+        return real;
+    }
+    return 0;
+}
+
+double lazy_value::as_double_or_throw(const std::string& context) const {
+    if (type::real != json_type()) {
+        throw access_error("double", context);
+    }
+    return as_double();
+}
+
+bool lazy_value::as_bool() const {
+    if (type::boolean == json_type()) {
+        auto pr = parser<sl::io::span<const char>>(tail());
+        pr.peek();
+        bool boolean = false;
+        pr.read_literal(boolean);
+        return boolean;
+    }
+    return false;
+}
+
+bool lazy_value::as_bool_or_throw(const std::string& context) const {
+    if (type::boolean != json_type()) {
+        throw access_error("boolean", context);
+    }
+    return as_bool();
+}
+
+value lazy_value::to_value() const {
+    if (nullptr == doc) {
+        return value();
+    }
+    auto pr = parser<sl::io::span<const char>>(tail());
+    return pr.parse();
+}
+
+sl::io::span<const char> lazy_value::tail() const {
+    return sl::io::span<const char>(doc->data.data() + offset, doc->data.size() - offset);
+}
+
+json_exception lazy_value::access_error(const std::string& target, const std::string& context) const {
+    return json_exception(TRACEMSG("Cannot access '" + target + "'" +
+            " from target value: [" + to_value().dumps() + "]," +
+            " context: [" + context + "]"));
+}
+
+lazy_document::lazy_document(sl::io::span<const char> data) :
+data(data) {
+    const char* bytes = data.data();
+    size_t len = data.size();
+    size_t pos = 0;
+    while (pos < len && is_whitespace(bytes[pos])) {
+        pos += 1;
+    }
+    if (pos == len) {
+        throw make_error("unexpected end of input", pos);
+    }
+    root_offset = pos;
+    if ('{' != bytes[pos] && '[' != bytes[pos]) {
+        return;
+    }
+    auto stack = std::vector<size_t>();
+    while (pos < len) {
+        pos = static_cast<size_t> (detail_parser::find_structural(bytes + pos, bytes + len) - bytes);
+        if (pos == len) {
+            break;
+        }
+        char ch = bytes[pos];
+        switch (ch) {
+        case '"':
+            pos = skip_string(bytes, len, pos);
+            continue;
+        case '{':
+        case '[':
+            if (stack.size() >= detail_parser::max_depth) {
+                throw make_error("maximum parsing depth reached", pos);
+            }
+            stack.push_back(extents.size());
+            // start offset is kept in 'end' until the container is closed
+            extents.push_back({pos, 0});
+            break;
+        case '}':
+        case ']': {
+            if (stack.empty()) {
+                throw make_error("invalid token", pos);
+            }
+            auto& ext = extents[stack.back()];
+            char open = bytes[ext.end];
+            if (('{' == open && '}' != ch) || ('[' == open && ']' != ch)) {
+                throw make_error('{' == open ? "'}' expected" : "']' expected", pos);
+            }
+            ext.end = pos + 1;
+            ext.next = extents.size();
+            stack.pop_back();
+            if (stack.empty()) {
+                return;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        pos += 1;
+    }
+    throw make_error("unexpected end of input", pos);
+}
+
+lazy_document::lazy_document(lazy_document&& other) :
+data(other.data),
+extents(std::move(other.extents)),
+root_offset(other.root_offset) { }
+
+lazy_value lazy_document::root() const {
+    return lazy_value(this, root_offset, 0);
+}
+
+lazy_value lazy_document::operator[](const std::string& name) const {
+    return root().getattr(name);
+}
+
+} // namespace
+}
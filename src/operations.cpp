@@ -23,21 +23,23 @@
 
 #include "staticlib/json/operations.hpp"
 
-#include "jansson_ops.hpp"
+#include "staticlib/json/parser.hpp"
 
 namespace staticlib {
 namespace json {
 
 value load(std::streambuf* src) {
-    return jansson_load_from_streambuf(src);
+    auto pr = parser<sl::io::streambuf_source>(sl::io::streambuf_source(src));
+    return pr.parse();
 }
 
 value loads(const std::string& str) {
-    return jansson_load_from_string(str);
+    auto pr = parser<sl::io::span<const char>>({str.data(), str.length()});
+    return pr.parse();
 }
 
-std::string dumps(const value& json) {
-    return json.dumps();
+std::string dumps(const value& json, const dump_options& options) {
+    return json.dumps(options);
 }
 
 const value& null_value_ref() {
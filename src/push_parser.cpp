@@ -0,0 +1,519 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   push_parser.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:02 AM
+ */
+
+#include "staticlib/json/push_parser.hpp"
+
+#include <cstring>
+
+#include "staticlib/support.hpp"
+
+namespace staticlib {
+namespace json {
+
+namespace { // anonymous
+
+using detail_push_parser::expect;
+using detail_push_parser::lexeme;
+
+bool is_digit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+bool is_number_byte(char ch) {
+    return is_digit(ch) || '-' == ch || '+' == ch || '.' == ch || 'e' == ch || 'E' == ch;
+}
+
+bool is_literal_byte(char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+// returns error message or nullptr for valid numbers
+const char* check_number(const std::string& num, bool& real) {
+    size_t i = 0;
+    size_t len = num.length();
+    if (i < len && '-' == num[i]) {
+        i += 1;
+    }
+    if (i < len && '0' == num[i]) {
+        i += 1;
+        if (i < len && is_digit(num[i])) {
+            return "invalid number, leading zeroes are not allowed";
+        }
+    } else if (i < len && is_digit(num[i])) {
+        while (i < len && is_digit(num[i])) {
+            i += 1;
+        }
+    } else {
+        return "invalid token";
+    }
+    real = false;
+    if (i < len && '.' == num[i]) {
+        real = true;
+        i += 1;
+        if (!(i < len && is_digit(num[i]))) {
+            return "invalid number, digit expected after decimal point";
+        }
+        while (i < len && is_digit(num[i])) {
+            i += 1;
+        }
+    }
+    if (i < len && ('e' == num[i] || 'E' == num[i])) {
+        real = true;
+        i += 1;
+        if (i < len && ('+' == num[i] || '-' == num[i])) {
+            i += 1;
+        }
+        if (!(i < len && is_digit(num[i]))) {
+            return "invalid number, digit expected in exponent";
+        }
+        while (i < len && is_digit(num[i])) {
+            i += 1;
+        }
+    }
+    return i == len ? nullptr : "invalid token";
+}
+
+std::string to_hex(uint32_t num) {
+    static const char* digits = "0123456789abcdef";
+    std::string res;
+    do {
+        res.insert(res.begin(), digits[num & 0xf]);
+        num >>= 4;
+    } while (num > 0);
+    if (res.length() < 2) {
+        res.insert(res.begin(), '0');
+    }
+    return res;
+}
+
+} // namespace
+
+push_parser::push_parser() { }
+
+push_parser::push_parser(push_parser&& other) :
+stack(std::move(other.stack)),
+completed(std::move(other.completed)),
+lex(other.lex),
+string_is_key(other.string_is_key),
+strbuf(std::move(other.strbuf)),
+tokbuf(std::move(other.tokbuf)),
+unicode_cp(other.unicode_cp),
+unicode_digits(other.unicode_digits),
+high_surrogate(other.high_surrogate),
+utf8_len(other.utf8_len),
+utf8_filled(other.utf8_filled),
+consumed(other.consumed),
+current(other.current),
+line(other.line),
+line_start(other.line_start),
+failed(other.failed) {
+    std::memcpy(utf8_seq, other.utf8_seq, sizeof(utf8_seq));
+}
+
+size_t push_parser::feed(sl::io::span<const char> chunk) {
+    if (failed) {
+        throw json_exception(TRACEMSG("Push parser is in failed state after the previous error"));
+    }
+    const char* begin = chunk.data();
+    const char* end = begin + chunk.size();
+    const char* pos = begin;
+    try {
+        while (pos < end) {
+            if (lexeme::string == lex && 0 == high_surrogate) {
+                pos = copy_plain(pos, end);
+                if (pos == end) {
+                    break;
+                }
+            }
+            current = consumed + static_cast<size_t> (pos - begin);
+            process_byte(*pos);
+            pos += 1;
+        }
+    } catch (...) {
+        failed = true;
+        throw;
+    }
+    consumed += chunk.size();
+    current = consumed;
+    return completed.size();
+}
+
+size_t push_parser::finish() {
+    if (failed) {
+        throw json_exception(TRACEMSG("Push parser is in failed state after the previous error"));
+    }
+    current = consumed;
+    try {
+        if (stack.empty()) {
+            if (lexeme::number == lex) {
+                complete_number();
+            } else if (lexeme::literal == lex) {
+                complete_literal();
+            }
+        }
+        if (in_progress()) {
+            throw make_error("premature end of input");
+        }
+    } catch (...) {
+        failed = true;
+        throw;
+    }
+    return completed.size();
+}
+
+bool push_parser::has_value() const {
+    return !completed.empty();
+}
+
+value push_parser::pop_value() {
+    if (completed.empty()) {
+        throw json_exception(TRACEMSG("No completed JSON values available"));
+    }
+    value res = std::move(completed.front());
+    completed.pop_front();
+    return res;
+}
+
+bool push_parser::in_progress() const {
+    return !stack.empty() || lexeme::none != lex;
+}
+
+size_t push_parser::position() const {
+    return consumed;
+}
+
+const char* push_parser::copy_plain(const char* pos, const char* end) {
+    const char* run = pos;
+    pos = detail_parser::find_string_special(pos, end);
+    if (pos > run) {
+        strbuf.append(run, static_cast<size_t> (pos - run));
+    }
+    return pos;
+}
+
+void push_parser::process_byte(char ch) {
+    switch (lex) {
+    case lexeme::string: process_string(ch);
+        return;
+    case lexeme::string_escape: process_escape(ch);
+        return;
+    case lexeme::string_unicode: process_unicode(ch);
+        return;
+    case lexeme::string_utf8: process_utf8(ch);
+        return;
+    case lexeme::number:
+        if (is_number_byte(ch)) {
+            tokbuf.push_back(ch);
+            return;
+        }
+        complete_number();
+        break;
+    case lexeme::literal:
+        if (is_literal_byte(ch)) {
+            tokbuf.push_back(ch);
+            return;
+        }
+        complete_literal();
+        break;
+    case lexeme::none:
+        break;
+    }
+    process_structural(ch);
+}
+
+void push_parser::process_string(char ch) {
+    if (0 != high_surrogate && '\\' != ch) {
+        throw make_error("invalid Unicode, low surrogate expected after: [" + to_hex(high_surrogate) + "]");
+    }
+    unsigned char uch = static_cast<unsigned char> (ch);
+    if ('"' == ch) {
+        complete_string();
+    } else if ('\\' == ch) {
+        lex = lexeme::string_escape;
+    } else if (uch < 0x20) {
+        throw make_error("control character 0x" + to_hex(uch) + " in string");
+    } else if (uch < 0x80) {
+        strbuf.push_back(ch);
+    } else {
+        size_t len = detail_parser::utf8_sequence_length(uch);
+        if (0 == len) {
+            throw make_error("unable to decode byte 0x" + to_hex(uch));
+        }
+        utf8_seq[0] = uch;
+        utf8_len = len;
+        utf8_filled = 1;
+        lex = lexeme::string_utf8;
+    }
+}
+
+void push_parser::process_escape(char ch) {
+    if (0 != high_surrogate && 'u' != ch) {
+        throw make_error("invalid Unicode, low surrogate expected after: [" + to_hex(high_surrogate) + "]");
+    }
+    lex = lexeme::string;
+    switch (ch) {
+    case '"': strbuf.push_back('"');
+        break;
+    case '\\': strbuf.push_back('\\');
+        break;
+    case '/': strbuf.push_back('/');
+        break;
+    case 'b': strbuf.push_back('\b');
+        break;
+    case 'f': strbuf.push_back('\f');
+        break;
+    case 'n': strbuf.push_back('\n');
+        break;
+    case 'r': strbuf.push_back('\r');
+        break;
+    case 't': strbuf.push_back('\t');
+        break;
+    case 'u':
+        unicode_cp = 0;
+        unicode_digits = 0;
+        lex = lexeme::string_unicode;
+        break;
+    default: throw make_error("invalid escape");
+    }
+}
+
+void push_parser::process_unicode(char ch) {
+    uint32_t digit;
+    if (ch >= '0' && ch <= '9') {
+        digit = static_cast<uint32_t> (ch - '0');
+    } else if (ch >= 'a' && ch <= 'f') {
+        digit = static_cast<uint32_t> (ch - 'a' + 10);
+    } else if (ch >= 'A' && ch <= 'F') {
+        digit = static_cast<uint32_t> (ch - 'A' + 10);
+    } else {
+        throw make_error("invalid escape, hex digit expected");
+    }
+    unicode_cp = (unicode_cp << 4) | digit;
+    unicode_digits += 1;
+    if (unicode_digits < 4) {
+        return;
+    }
+    lex = lexeme::string;
+    uint32_t cp = unicode_cp;
+    if (0 != high_surrogate) {
+        if (cp < 0xdc00 || cp > 0xdfff) {
+            throw make_error("invalid Unicode, low surrogate expected after: [" + to_hex(high_surrogate) + "]");
+        }
+        cp = (((high_surrogate - 0xd800) << 10) | (cp - 0xdc00)) + 0x10000;
+        high_surrogate = 0;
+    } else if (cp >= 0xd800 && cp <= 0xdbff) {
+        // wait for the low surrogate
+        high_surrogate = cp;
+        return;
+    } else if (cp >= 0xdc00 && cp <= 0xdfff) {
+        throw make_error("invalid Unicode: [" + to_hex(cp) + "]");
+    } else if (0 == cp) {
+        throw make_error("\\u0000 is not allowed");
+    }
+    detail_parser::utf8_append(cp, strbuf);
+}
+
+void push_parser::process_utf8(char ch) {
+    utf8_seq[utf8_filled] = static_cast<unsigned char> (ch);
+    utf8_filled += 1;
+    if (utf8_filled < utf8_len) {
+        return;
+    }
+    if (!detail_parser::utf8_sequence_valid(utf8_seq, utf8_len)) {
+        throw make_error("unable to decode byte 0x" + to_hex(utf8_seq[0]));
+    }
+    strbuf.append(reinterpret_cast<const char*> (utf8_seq), utf8_len);
+    lex = lexeme::string;
+}
+
+void push_parser::process_structural(char ch) {
+    switch (ch) {
+    case '\n':
+        line += 1;
+        line_start = current + 1;
+        return;
+    case ' ': case '\t': case '\r':
+        return;
+    default:
+        break;
+    }
+    if (stack.empty()) {
+        start_value(ch);
+        return;
+    }
+    auto& top = stack.back();
+    switch (top.exp) {
+    case expect::value:
+        start_value(ch);
+        break;
+    case expect::value_or_end:
+        if (']' == ch) {
+            close_container(ch);
+        } else {
+            start_value(ch);
+        }
+        break;
+    case expect::key:
+    case expect::key_or_end:
+        if ('"' == ch) {
+            strbuf.clear();
+            string_is_key = true;
+            lex = lexeme::string;
+        } else if ('}' == ch && expect::key_or_end == top.exp) {
+            close_container(ch);
+        } else {
+            throw make_error(expect::key_or_end == top.exp ? "string or '}' expected" : "string expected");
+        }
+        break;
+    case expect::colon:
+        if (':' != ch) {
+            throw make_error("':' expected");
+        }
+        top.exp = expect::value;
+        break;
+    case expect::comma_or_end:
+        if (',' == ch) {
+            top.exp = top.object ? expect::key : expect::value;
+        } else {
+            close_container(ch);
+        }
+        break;
+    }
+}
+
+void push_parser::start_value(char ch) {
+    switch (ch) {
+    case '{':
+    case '[':
+        if (stack.size() >= detail_parser::max_depth) {
+            throw make_error("maximum parsing depth reached");
+        }
+        stack.emplace_back('{' == ch);
+        break;
+    case '"':
+        strbuf.clear();
+        string_is_key = false;
+        lex = lexeme::string;
+        break;
+    case '-': case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        tokbuf.clear();
+        tokbuf.push_back(ch);
+        lex = lexeme::number;
+        break;
+    default:
+        if (!is_literal_byte(ch)) {
+            throw make_error("invalid token");
+        }
+        tokbuf.clear();
+        tokbuf.push_back(ch);
+        lex = lexeme::literal;
+    }
+}
+
+void push_parser::close_container(char ch) {
+    auto& top = stack.back();
+    if (top.object && '}' != ch) {
+        throw make_error("'}' expected");
+    }
+    if (!top.object && ']' != ch) {
+        throw make_error("']' expected");
+    }
+    value val = top.object ? value(std::move(top.fields)) : value(std::move(top.values));
+    stack.pop_back();
+    complete_value(std::move(val));
+}
+
+void push_parser::complete_value(value&& val) {
+    if (stack.empty()) {
+        completed.emplace_back(std::move(val));
+        return;
+    }
+    auto& top = stack.back();
+    if (top.object) {
+        top.fields.emplace_back(std::move(top.key), std::move(val));
+        if (top.checker.last_is_duplicate()) {
+            throw make_error("duplicate object key: [" + top.fields.back().name() + "]");
+        }
+    } else {
+        top.values.emplace_back(std::move(val));
+    }
+    top.exp = expect::comma_or_end;
+}
+
+void push_parser::complete_string() {
+    lex = lexeme::none;
+    if (string_is_key) {
+        auto& top = stack.back();
+        top.key = strbuf;
+        top.exp = expect::colon;
+    } else {
+        complete_value(value(strbuf));
+    }
+}
+
+void push_parser::complete_number() {
+    lex = lexeme::none;
+    bool real = false;
+    const char* err = check_number(tokbuf, real);
+    if (nullptr != err) {
+        throw make_error(err);
+    }
+    if (real) {
+        double res = 0;
+        if (!detail_parser::parse_real(tokbuf, res)) {
+            throw make_error("real number overflow");
+        }
+        complete_value(value(res));
+    } else {
+        int64_t res = 0;
+        if (!detail_parser::parse_integer(tokbuf, res)) {
+            throw make_error('-' == tokbuf[0] ? "too big negative integer" : "too big integer");
+        }
+        complete_value(value(res));
+    }
+}
+
+void push_parser::complete_literal() {
+    lex = lexeme::none;
+    if ("true" == tokbuf) {
+        complete_value(value(true));
+    } else if ("false" == tokbuf) {
+        complete_value(value(false));
+    } else if ("null" == tokbuf) {
+        complete_value(value());
+    } else {
+        throw make_error("invalid token");
+    }
+}
+
+json_exception push_parser::make_error(const std::string& text) {
+    return json_exception(TRACEMSG("Error parsing JSON:" +
+            " text: [" + text + "]" +
+            " line: [" + sl::support::to_string(line) + "]" +
+            " column: [" + sl::support::to_string(current - line_start + 1) + "]" +
+            " position: [" + sl::support::to_string(current) + "]"));
+}
+
+} // namespace
+}
@@ -0,0 +1,627 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   scan.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:30 PM
+ */
+
+#include "staticlib/json/parser.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#include "scan_ops.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define STATICLIB_JSON_SCAN_X86_64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define STATICLIB_JSON_TARGET_AVX2
+#else // !_MSC_VER
+#define STATICLIB_JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#endif // _MSC_VER
+#endif // x86_64
+
+namespace staticlib {
+namespace json {
+namespace detail_parser {
+
+namespace { // anonymous
+
+typedef const char* (*find_fun)(const char*, const char*);
+
+typedef const char* (*skip_fun)(const char*, const char*, size_t&, const char*&);
+
+bool is_whitespace(char ch) {
+    return ' ' == ch || '\n' == ch || '\t' == ch || '\r' == ch;
+}
+
+bool is_structural(char ch) {
+    return '"' == ch || '{' == ch || '}' == ch || '[' == ch || ']' == ch;
+}
+
+bool needs_escape(unsigned char ch) {
+    return '"' == ch || '\\' == ch || ch < 0x20;
+}
+
+// scalar implementations, also used for tails
+
+const char* find_string_special_scalar(const char* pos, const char* end) {
+    while (pos < end && is_plain_string_byte(static_cast<unsigned char> (*pos))) {
+        pos += 1;
+    }
+    return pos;
+}
+
+const char* skip_whitespace_scalar(const char* pos, const char* end, size_t& lines, const char*& last_line_feed) {
+    while (pos < end && is_whitespace(*pos)) {
+        if ('\n' == *pos) {
+            lines += 1;
+            last_line_feed = pos;
+        }
+        pos += 1;
+    }
+    return pos;
+}
+
+const char* find_structural_scalar(const char* pos, const char* end) {
+    while (pos < end && !is_structural(*pos)) {
+        pos += 1;
+    }
+    return pos;
+}
+
+const char* find_escape_special_scalar(const char* pos, const char* end) {
+    while (pos < end && !needs_escape(static_cast<unsigned char> (*pos))) {
+        pos += 1;
+    }
+    return pos;
+}
+
+const char* find_utf8_invalid_scalar(const char* pos, const char* end) {
+    while (pos < end) {
+        unsigned char ch = static_cast<unsigned char> (*pos);
+        if (ch < 0x80) {
+            pos += 1;
+            continue;
+        }
+        size_t len = utf8_sequence_length(ch);
+        if (0 == len || static_cast<size_t> (end - pos) < len ||
+                !utf8_sequence_valid(reinterpret_cast<const unsigned char*> (pos), len)) {
+            return pos;
+        }
+        pos += len;
+    }
+    return end;
+}
+
+#ifdef STATICLIB_JSON_SCAN_X86_64
+
+unsigned lowest_bit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long res;
+    _BitScanForward(&res, mask);
+    return static_cast<unsigned> (res);
+#else // !_MSC_VER
+    return static_cast<unsigned> (__builtin_ctz(mask));
+#endif // _MSC_VER
+}
+
+unsigned highest_bit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long res;
+    _BitScanReverse(&res, mask);
+    return static_cast<unsigned> (res);
+#else // !_MSC_VER
+    return static_cast<unsigned> (31 - __builtin_clz(mask));
+#endif // _MSC_VER
+}
+
+size_t count_bits(uint32_t mask) {
+    size_t res = 0;
+    while (0 != mask) {
+        mask &= mask - 1;
+        res += 1;
+    }
+    return res;
+}
+
+// newlines before the stop index are counted
+void count_line_feeds(const char* block, uint32_t nl_mask, size_t& lines, const char*& last_line_feed) {
+    if (0 != nl_mask) {
+        lines += count_bits(nl_mask);
+        last_line_feed = block + highest_bit(nl_mask);
+    }
+}
+
+// SSE2 is always available on x86_64
+
+const char* find_string_special_sse2(const char* pos, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i space = _mm_set1_epi8(0x20);
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (pos));
+        // signed comparison catches both control and non-ASCII bytes
+        __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+                _mm_cmplt_epi8(block, space));
+        uint32_t mask = static_cast<uint32_t> (_mm_movemask_epi8(special));
+        if (0 != mask) {
+            return pos + lowest_bit(mask);
+        }
+        pos += 16;
+    }
+    return find_string_special_scalar(pos, end);
+}
+
+const char* skip_whitespace_sse2(const char* pos, const char* end, size_t& lines, const char*& last_line_feed) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i line_feed = _mm_set1_epi8('\n');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (pos));
+        __m128i nl = _mm_cmpeq_epi8(block, line_feed);
+        __m128i ws = _mm_or_si128(_mm_or_si128(nl, _mm_cmpeq_epi8(block, space)),
+                _mm_or_si128(_mm_cmpeq_epi8(block, tab), _mm_cmpeq_epi8(block, carriage_return)));
+        uint32_t nl_mask = static_cast<uint32_t> (_mm_movemask_epi8(nl));
+        uint32_t stop_mask = ~static_cast<uint32_t> (_mm_movemask_epi8(ws)) & 0xffff;
+        if (0 != stop_mask) {
+            unsigned idx = lowest_bit(stop_mask);
+            count_line_feeds(pos, nl_mask & ((1u << idx) - 1), lines, last_line_feed);
+            return pos + idx;
+        }
+        count_line_feeds(pos, nl_mask, lines, last_line_feed);
+        pos += 16;
+    }
+    return skip_whitespace_scalar(pos, end, lines, last_line_feed);
+}
+
+const char* find_structural_sse2(const char* pos, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i curly_open = _mm_set1_epi8('{');
+    const __m128i curly_close = _mm_set1_epi8('}');
+    const __m128i square_open = _mm_set1_epi8('[');
+    const __m128i square_close = _mm_set1_epi8(']');
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (pos));
+        __m128i st = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote),
+                _mm_or_si128(_mm_cmpeq_epi8(block, curly_open), _mm_cmpeq_epi8(block, curly_close))),
+                _mm_or_si128(_mm_cmpeq_epi8(block, square_open), _mm_cmpeq_epi8(block, square_close)));
+        uint32_t mask = static_cast<uint32_t> (_mm_movemask_epi8(st));
+        if (0 != mask) {
+            return pos + lowest_bit(mask);
+        }
+        pos += 16;
+    }
+    return find_structural_scalar(pos, end);
+}
+
+const char* find_escape_special_sse2(const char* pos, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (pos));
+        // unsigned comparison, non-ASCII bytes are not escaped
+        __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+                _mm_cmpeq_epi8(_mm_min_epu8(block, control), block));
+        uint32_t mask = static_cast<uint32_t> (_mm_movemask_epi8(special));
+        if (0 != mask) {
+            return pos + lowest_bit(mask);
+        }
+        pos += 16;
+    }
+    return find_escape_special_scalar(pos, end);
+}
+
+const char* find_utf8_invalid_sse2(const char* pos, const char* end) {
+    // only ASCII blocks are skipped, sequences are checked one by one
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (pos));
+        if (0 != _mm_movemask_epi8(block)) {
+            const char* block_end = pos + 16;
+            while (pos < block_end) {
+                unsigned char ch = static_cast<unsigned char> (*pos);
+                if (ch < 0x80) {
+                    pos += 1;
+                    continue;
+                }
+                size_t len = utf8_sequence_length(ch);
+                if (0 == len || static_cast<size_t> (end - pos) < len ||
+                        !utf8_sequence_valid(reinterpret_cast<const unsigned char*> (pos), len)) {
+                    return pos;
+                }
+                pos += len;
+            }
+        } else {
+            pos += 16;
+        }
+    }
+    return find_utf8_invalid_scalar(pos, end);
+}
+
+// error flags of the lookup algorithm, are set by the first byte high nibble,
+// the first byte low nibble and the second byte high nibble, error is reported
+// when the flag is set by all three lookups
+const uint8_t utf8_too_short = 1 << 0;
+const uint8_t utf8_too_long = 1 << 1;
+const uint8_t utf8_overlong_3 = 1 << 2;
+const uint8_t utf8_too_large = 1 << 3;
+const uint8_t utf8_surrogate = 1 << 4;
+const uint8_t utf8_overlong_2 = 1 << 5;
+const uint8_t utf8_too_large_1000 = 1 << 6;
+const uint8_t utf8_overlong_4 = 1 << 6;
+const uint8_t utf8_two_conts = 1 << 7;
+const uint8_t utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts;
+
+const uint8_t utf8_byte_1_high[16] = {
+    // ASCII
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    // continuation
+    utf8_two_conts, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+    // 1100____
+    utf8_too_short | utf8_overlong_2,
+    // 1101____
+    utf8_too_short,
+    // 1110____
+    utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+    // 1111____
+    utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4
+};
+
+const uint8_t utf8_byte_1_low[16] = {
+    // ____0000
+    utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+    // ____0001
+    utf8_carry | utf8_overlong_2,
+    // ____001_
+    utf8_carry,
+    utf8_carry,
+    // ____0100
+    utf8_carry | utf8_too_large,
+    // ____0101 - ____1100
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    // ____1101
+    utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+    // ____111_
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000
+};
+
+const uint8_t utf8_byte_2_high[16] = {
+    // ASCII
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    // 1000____
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+    // 1001____
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large,
+    // 101_____
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    // lead bytes
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short
+};
+
+STATICLIB_JSON_TARGET_AVX2
+const char* find_string_special_avx2(const char* pos, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i space = _mm256_set1_epi8(0x20);
+    while (end - pos >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (pos));
+        __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+                _mm256_cmpgt_epi8(space, block));
+        uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(special));
+        if (0 != mask) {
+            return pos + lowest_bit(mask);
+        }
+        pos += 32;
+    }
+    return find_string_special_sse2(pos, end);
+}
+
+STATICLIB_JSON_TARGET_AVX2
+const char* skip_whitespace_avx2(const char* pos, const char* end, size_t& lines, const char*& last_line_feed) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i line_feed = _mm256_set1_epi8('\n');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+    while (end - pos >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (pos));
+        __m256i nl = _mm256_cmpeq_epi8(block, line_feed);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(nl, _mm256_cmpeq_epi8(block, space)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, tab), _mm256_cmpeq_epi8(block, carriage_return)));
+        uint32_t nl_mask = static_cast<uint32_t> (_mm256_movemask_epi8(nl));
+        uint32_t stop_mask = ~static_cast<uint32_t> (_mm256_movemask_epi8(ws));
+        if (0 != stop_mask) {
+            unsigned idx = lowest_bit(stop_mask);
+            count_line_feeds(pos, nl_mask & ((1u << idx) - 1), lines, last_line_feed);
+            return pos + idx;
+        }
+        count_line_feeds(pos, nl_mask, lines, last_line_feed);
+        pos += 32;
+    }
+    return skip_whitespace_sse2(pos, end, lines, last_line_feed);
+}
+
+STATICLIB_JSON_TARGET_AVX2
+const char* find_structural_avx2(const char* pos, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i curly_open = _mm256_set1_epi8('{');
+    const __m256i curly_close = _mm256_set1_epi8('}');
+    const __m256i square_open = _mm256_set1_epi8('[');
+    const __m256i square_close = _mm256_set1_epi8(']');
+    while (end - pos >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (pos));
+        __m256i st = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, quote),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, curly_open), _mm256_cmpeq_epi8(block, curly_close))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, square_open), _mm256_cmpeq_epi8(block, square_close)));
+        uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(st));
+        if (0 != mask) {
+            return pos + lowest_bit(mask);
+        }
+        pos += 32;
+    }
+    return find_structural_sse2(pos, end);
+}
+
+STATICLIB_JSON_TARGET_AVX2
+const char* find_escape_special_avx2(const char* pos, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1f);
+    while (end - pos >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (pos));
+        __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+                _mm256_cmpeq_epi8(_mm256_min_epu8(block, control), block));
+        uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(special));
+        if (0 != mask) {
+            return pos + lowest_bit(mask);
+        }
+        pos += 32;
+    }
+    return find_escape_special_sse2(pos, end);
+}
+
+STATICLIB_JSON_TARGET_AVX2
+__m256i utf8_lookup(const uint8_t* table, __m256i nibbles) {
+    __m256i tb = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*> (table)));
+    return _mm256_shuffle_epi8(tb, nibbles);
+}
+
+STATICLIB_JSON_TARGET_AVX2
+const char* find_utf8_invalid_avx2(const char* pos, const char* end) {
+    const char* start = pos;
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+    const __m256i third_byte_min = _mm256_set1_epi8(static_cast<char> (0xe0 - 0x80));
+    const __m256i fourth_byte_min = _mm256_set1_epi8(static_cast<char> (0xf0 - 0x80));
+    const __m256i high_bit = _mm256_set1_epi8(static_cast<char> (0x80));
+    // lead bytes that need more bytes than are left in the block
+    const __m256i incomplete_max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, static_cast<char> (0xf0 - 1), static_cast<char> (0xe0 - 1),
+            static_cast<char> (0xc0 - 1));
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    __m256i error = _mm256_setzero_si256();
+    char tail[32];
+    while (pos < end) {
+        __m256i input;
+        if (end - pos >= 32) {
+            input = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (pos));
+            pos += 32;
+        } else {
+            // padding is ASCII
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, pos, static_cast<size_t> (end - pos));
+            input = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (tail));
+            pos = end;
+        }
+        if (0 == _mm256_movemask_epi8(input)) {
+            error = _mm256_or_si256(error, prev_incomplete);
+        } else {
+            // previous bytes for each position, spanning the block boundary
+            __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            __m256i byte_1_high = utf8_lookup(utf8_byte_1_high,
+                    _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble_mask));
+            __m256i byte_1_low = utf8_lookup(utf8_byte_1_low, _mm256_and_si256(prev1, nibble_mask));
+            __m256i byte_2_high = utf8_lookup(utf8_byte_2_high,
+                    _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask));
+            __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+            // third and fourth bytes of sequences must be continuations
+            __m256i must_continue = _mm256_and_si256(_mm256_or_si256(
+                    _mm256_subs_epu8(prev2, third_byte_min),
+                    _mm256_subs_epu8(prev3, fourth_byte_min)), high_bit);
+            error = _mm256_or_si256(error, _mm256_xor_si256(must_continue, special));
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+        }
+        prev_input = input;
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    if (!_mm256_testz_si256(error, error)) {
+        // position of the invalid sequence is found by the scalar check
+        return find_utf8_invalid_scalar(start, end);
+    }
+    return end;
+}
+
+bool cpu_has_avx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    // OSXSAVE and AVX
+    if (0x18000000 != (info[2] & 0x18000000)) {
+        return false;
+    }
+    // OS saves YMM registers
+    if (0x6 != (_xgetbv(0) & 0x6)) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return 0 != (info[1] & 0x20);
+#else // !_MSC_VER
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+}
+
+find_fun select_string_special() {
+    return cpu_has_avx2() ? find_string_special_avx2 : find_string_special_sse2;
+}
+
+skip_fun select_whitespace() {
+    return cpu_has_avx2() ? skip_whitespace_avx2 : skip_whitespace_sse2;
+}
+
+find_fun select_structural() {
+    return cpu_has_avx2() ? find_structural_avx2 : find_structural_sse2;
+}
+
+find_fun select_escape_special() {
+    return cpu_has_avx2() ? find_escape_special_avx2 : find_escape_special_sse2;
+}
+
+find_fun select_utf8_invalid() {
+    return cpu_has_avx2() ? find_utf8_invalid_avx2 : find_utf8_invalid_sse2;
+}
+
+#else // !STATICLIB_JSON_SCAN_X86_64
+
+find_fun select_string_special() {
+    return find_string_special_scalar;
+}
+
+skip_fun select_whitespace() {
+    return skip_whitespace_scalar;
+}
+
+find_fun select_structural() {
+    return find_structural_scalar;
+}
+
+find_fun select_escape_special() {
+    return find_escape_special_scalar;
+}
+
+find_fun select_utf8_invalid() {
+    return find_utf8_invalid_scalar;
+}
+
+#endif // STATICLIB_JSON_SCAN_X86_64
+
+// implementations are selected on the first call, pointers are
+// initialized statically to not depend on the initialization order
+
+const char* resolve_string_special(const char* pos, const char* end);
+
+const char* resolve_whitespace(const char* pos, const char* end, size_t& lines, const char*& last_line_feed);
+
+const char* resolve_structural(const char* pos, const char* end);
+
+const char* resolve_escape_special(const char* pos, const char* end);
+
+const char* resolve_utf8_invalid(const char* pos, const char* end);
+
+std::atomic<find_fun> string_special_impl(resolve_string_special);
+
+std::atomic<skip_fun> whitespace_impl(resolve_whitespace);
+
+std::atomic<find_fun> structural_impl(resolve_structural);
+
+std::atomic<find_fun> escape_special_impl(resolve_escape_special);
+
+std::atomic<find_fun> utf8_invalid_impl(resolve_utf8_invalid);
+
+const char* resolve_string_special(const char* pos, const char* end) {
+    find_fun fun = select_string_special();
+    string_special_impl.store(fun, std::memory_order_relaxed);
+    return fun(pos, end);
+}
+
+const char* resolve_whitespace(const char* pos, const char* end, size_t& lines, const char*& last_line_feed) {
+    skip_fun fun = select_whitespace();
+    whitespace_impl.store(fun, std::memory_order_relaxed);
+    return fun(pos, end, lines, last_line_feed);
+}
+
+const char* resolve_structural(const char* pos, const char* end) {
+    find_fun fun = select_structural();
+    structural_impl.store(fun, std::memory_order_relaxed);
+    return fun(pos, end);
+}
+
+const char* resolve_escape_special(const char* pos, const char* end) {
+    find_fun fun = select_escape_special();
+    escape_special_impl.store(fun, std::memory_order_relaxed);
+    return fun(pos, end);
+}
+
+const char* resolve_utf8_invalid(const char* pos, const char* end) {
+    find_fun fun = select_utf8_invalid();
+    utf8_invalid_impl.store(fun, std::memory_order_relaxed);
+    return fun(pos, end);
+}
+
+} // namespace
+
+const char* find_string_special(const char* pos, const char* end) {
+    return string_special_impl.load(std::memory_order_relaxed)(pos, end);
+}
+
+const char* skip_whitespace(const char* pos, const char* end, size_t& lines, const char*& last_line_feed) {
+    return whitespace_impl.load(std::memory_order_relaxed)(pos, end, lines, last_line_feed);
+}
+
+const char* find_structural(const char* pos, const char* end) {
+    return structural_impl.load(std::memory_order_relaxed)(pos, end);
+}
+
+const char* find_escape_special(const char* pos, const char* end) {
+    return escape_special_impl.load(std::memory_order_relaxed)(pos, end);
+}
+
+const char* find_utf8_invalid(const char* pos, const char* end) {
+    return utf8_invalid_impl.load(std::memory_order_relaxed)(pos, end);
+}
+
+} // namespace
+}
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   scan_ops.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 6:10 PM
+ */
+
+#ifndef STATICLIB_JSON_SCAN_OPS_HPP
+#define STATICLIB_JSON_SCAN_OPS_HPP
+
+namespace staticlib {
+namespace json {
+namespace detail_parser {
+
+// scanning of the string data for serializer, implemented in scan.cpp
+// along with the scanning functions used by parser
+
+/**
+ * Finds the first byte that must be escaped when string is dumped
+ * (quote, backslash or control character), scans 16 or 32 bytes at a time
+ * on x86 using SSE2 or AVX2 (selected at runtime)
+ *
+ * @param pos start of the data
+ * @param end end of the data
+ * @return pointer to the first byte to escape, or `end`
+ */
+const char* find_escape_special(const char* pos, const char* end);
+
+/**
+ * Validates UTF-8 data, checks 32 bytes at a time on x86 with AVX2 (using
+ * the lookup algorithm from John Keiser and Daniel Lemire, "Validating UTF-8
+ * In Less Than One Instruction Per Byte", 2021), ASCII data is skipped 16 bytes
+ * at a time with SSE2
+ *
+ * @param pos start of the data
+ * @param end end of the data
+ * @return pointer to the first byte of the first invalid sequence
+ *         (see `utf8_sequence_valid`), or `end` if data is valid
+ */
+const char* find_utf8_invalid(const char* pos, const char* end);
+
+} // namespace
+}
+}
+
+#endif /* STATICLIB_JSON_SCAN_OPS_HPP */
@@ -23,37 +23,373 @@
 
 #include "staticlib/json/value.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+
 #include "staticlib/config.hpp"
 
 #include "staticlib/json/field.hpp"
 
-#include "jansson_ops.hpp"
+#include "dump_ops.hpp"
 
 namespace staticlib {
 namespace json {
 
+namespace detail_value {
+
+// open addressing table of field positions, is built only for
+// large objects, keeps the fields snapshot to detect appends and removals,
+// found positions are always checked against the field name
+class object_index {
+    // field position + 1, zero marks an empty slot
+    std::vector<uint32_t> slots;
+    size_t mask = 0;
+    const field* data = nullptr;
+    size_t size = 0;
+
+public:
+    object_index(const std::vector<field>& fields) {
+        rebuild(fields);
+    }
+
+    bool matches(const std::vector<field>& fields) const {
+        return data == fields.data() && size == fields.size();
+    }
+
+    // returns fields count if not found
+    size_t find(const std::vector<field>& fields, const std::string& name) const {
+        size_t idx = std::hash<std::string>()(name) & mask;
+        for (;;) {
+            uint32_t sl = slots[idx];
+            if (0 == sl) {
+                return fields.size();
+            }
+            size_t pos = sl - 1;
+            const std::string& fname = fields[pos].name();
+            // interned names are compared by pointer first
+            if (std::addressof(name) == std::addressof(fname) || name == fname) {
+                return pos;
+            }
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    // registers the last field that was appended
+    void add_last(const std::vector<field>& fields) {
+        if (fields.size() * 2 > slots.size()) {
+            rebuild(fields);
+            return;
+        }
+        insert(fields, fields.size() - 1);
+        data = fields.data();
+        size = fields.size();
+    }
+
+private:
+    void rebuild(const std::vector<field>& fields) {
+        size_t cap = 16;
+        while (cap < fields.size() * 2) {
+            cap *= 2;
+        }
+        slots.assign(cap, 0);
+        mask = cap - 1;
+        for (size_t i = 0; i < fields.size(); i++) {
+            insert(fields, i);
+        }
+        data = fields.data();
+        size = fields.size();
+    }
+
+    void insert(const std::vector<field>& fields, size_t pos) {
+        const std::string& name = fields[pos].name();
+        size_t idx = std::hash<std::string>()(name) & mask;
+        for (;;) {
+            uint32_t sl = slots[idx];
+            if (0 == sl) {
+                slots[idx] = static_cast<uint32_t> (pos + 1);
+                return;
+            }
+            // first field wins for duplicate names
+            if (name == fields[sl - 1].name()) {
+                return;
+            }
+            idx = (idx + 1) & mask;
+        }
+    }
+};
+
+class object_node {
+public:
+    std::vector<field> fields;
+    // built lazily from const methods and published with CAS,
+    // replaced or dropped only with exclusive access
+    mutable std::atomic<object_index*> index;
+    // set when mutable reference to fields was handed out, names may
+    // be changed through it, so index misses are not trusted anymore
+    bool fields_exposed;
+    // set when any mutable reference into this node was handed out,
+    // such node is copied instead of shared by 'clone_shared'
+    bool exposed;
+    // number of values sharing this node
+    mutable std::atomic<size_t> refs;
+
+    object_node(std::vector<field>&& fields) :
+    fields(std::move(fields)),
+    index(nullptr),
+    fields_exposed(false),
+    exposed(false),
+    refs(1) { }
+
+    ~object_node() STATICLIB_NOEXCEPT {
+        delete index.load(std::memory_order_relaxed);
+    }
+
+    void drop_index() {
+        delete index.exchange(nullptr, std::memory_order_relaxed);
+    }
+};
+
+// contiguous storage for arrays of numbers of the same type
+class packed_numbers {
+public:
+    type kind;
+    std::vector<int64_t> integers;
+    std::vector<double> reals;
+    // built lazily from const methods and published with CAS,
+    // taken away only with exclusive access
+    mutable std::atomic<std::vector<value>*> expanded;
+
+    packed_numbers(std::vector<int64_t>&& integers) :
+    kind(type::integer),
+    integers(std::move(integers)),
+    expanded(nullptr) { }
+
+    packed_numbers(std::vector<double>&& reals) :
+    kind(type::real),
+    reals(std::move(reals)),
+    expanded(nullptr) { }
+
+    ~packed_numbers() STATICLIB_NOEXCEPT {
+        delete expanded.load(std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<packed_numbers> copy() const {
+        if (type::integer == kind) {
+            auto vec = integers;
+            return std::unique_ptr<packed_numbers>(new packed_numbers(std::move(vec)));
+        }
+        auto vec = reals;
+        return std::unique_ptr<packed_numbers>(new packed_numbers(std::move(vec)));
+    }
+
+    std::vector<value> to_values() const {
+        auto vec = std::vector<value>();
+        if (type::integer == kind) {
+            vec.reserve(integers.size());
+            for (int64_t num : integers) {
+                vec.emplace_back(num);
+            }
+        } else {
+            vec.reserve(reals.size());
+            for (double num : reals) {
+                vec.emplace_back(num);
+            }
+        }
+        return vec;
+    }
+};
+
+class array_node {
+public:
+    std::vector<value> values;
+    // set for packed arrays, values are empty in this case
+    std::unique_ptr<packed_numbers> packed;
+    // set when mutable reference into this node was handed out,
+    // such node is copied instead of shared by 'clone_shared'
+    bool exposed;
+    // number of values sharing this node
+    mutable std::atomic<size_t> refs;
+
+    array_node(std::vector<value>&& values) :
+    values(std::move(values)),
+    exposed(false),
+    refs(1) { }
+
+    array_node(std::unique_ptr<packed_numbers>&& packed) :
+    packed(std::move(packed)),
+    exposed(false),
+    refs(1) { }
+};
+
+} // namespace
+
 namespace { // anonymous
 
+template<typename Node>
+bool is_shared(const Node* node) {
+    return node->refs.load(std::memory_order_acquire) > 1;
+}
+
+template<typename Node>
+void release_shared(Node* node) {
+    // last reference does not need an atomic decrement
+    if (!is_shared(node) || 1 == node->refs.fetch_sub(1, std::memory_order_acq_rel)) {
+        delete node;
+    }
+}
+
+// copies one level, nested nodes are shared
+detail_value::object_node* copy_node(const detail_value::object_node& node) {
+    auto vec = std::vector<field>();
+    vec.reserve(node.fields.size());
+    for (const field& fi : node.fields) {
+        vec.emplace_back(fi.clone_shared());
+    }
+    return new detail_value::object_node(std::move(vec));
+}
+
+// copies one level, nested nodes are shared
+detail_value::array_node* copy_node(const detail_value::array_node& node) {
+    if (nullptr != node.packed) {
+        return new detail_value::array_node(node.packed->copy());
+    }
+    auto vec = std::vector<value>();
+    vec.reserve(node.values.size());
+    for (const value& va : node.values) {
+        vec.emplace_back(va.clone_shared());
+    }
+    return new detail_value::array_node(std::move(vec));
+}
+
+// markers in value::string_info, smaller values are inline string lengths
+const uint8_t string_heap = 0xfe;
+// lowest bit of the borrowed marker keeps the lowest bit of borrowed pointer,
+// published std::string pointer is tagged to differ from it in this bit
+const uint8_t string_borrowed = 0xfc;
+const size_t inline_string_max = 6;
+// borrowed length is kept in string_head at 4-bytes aligned offset
+const size_t borrowed_length_offset = 2;
+
+std::atomic<uintptr_t>& string_word(const char* slot) {
+    static_assert(sizeof(std::atomic<uintptr_t>) == sizeof(void*), "Invalid atomic size");
+    return *reinterpret_cast<std::atomic<uintptr_t>*> (const_cast<char*> (slot));
+}
+
+void init_string_word(char* slot, uintptr_t word) {
+    new (slot) std::atomic<uintptr_t>(word);
+}
+
+bool is_borrowed(uint8_t info) {
+    return string_borrowed == (info & 0xfe);
+}
+
+std::atomic<size_t> object_index_threshold{32};
+
+// returns index that matches fields or nullptr
+detail_value::object_index* object_index_for(const detail_value::object_node& node) {
+    if (node.fields.size() < object_index_threshold.load(std::memory_order_relaxed) ||
+            node.fields.size() > std::numeric_limits<uint32_t>::max()) {
+        return nullptr;
+    }
+    auto idx = node.index.load(std::memory_order_acquire);
+    if (nullptr == idx) {
+        auto created = std::unique_ptr<detail_value::object_index>(
+                new detail_value::object_index(node.fields));
+        if (node.index.compare_exchange_strong(idx, created.get(),
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            idx = created.release();
+        }
+        // otherwise index published by other thread is used
+    }
+    // stale index can only be replaced with exclusive access
+    return idx->matches(node.fields) ? idx : nullptr;
+}
+
+// expands packed numbers on the first access
+const std::vector<value>& array_values(const detail_value::array_node& node) {
+    if (nullptr == node.packed) {
+        return node.values;
+    }
+    auto exp = node.packed->expanded.load(std::memory_order_acquire);
+    if (nullptr == exp) {
+        auto created = std::unique_ptr<std::vector<value>>(
+                new std::vector<value>(node.packed->to_values()));
+        if (node.packed->expanded.compare_exchange_strong(exp, created.get(),
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            exp = created.release();
+        }
+        // otherwise values expanded by other thread are used
+    }
+    return *exp;
+}
+
+// converts packed array into the generic one, requires exclusive access
+void unpack_array(detail_value::array_node& node) {
+    if (nullptr == node.packed) {
+        return;
+    }
+    auto exp = std::unique_ptr<std::vector<value>>(
+            node.packed->expanded.exchange(nullptr, std::memory_order_relaxed));
+    if (nullptr != exp) {
+        node.values = std::move(*exp);
+    } else {
+        node.values = node.packed->to_values();
+    }
+    node.packed.reset();
+}
+
+// returns fields count if not found
+size_t scan_fields(const std::vector<field>& fields, const std::string& name) {
+    for (size_t i = 0; i < fields.size(); i++) {
+        const std::string& fname = fields[i].name();
+        if (std::addressof(name) == std::addressof(fname) || name == fname) {
+            return i;
+        }
+    }
+    return fields.size();
+}
+
+// returns fields count if not found
+size_t find_field(const detail_value::object_node& node, const std::string& name) {
+    auto idx = object_index_for(node);
+    if (nullptr == idx) {
+        return scan_fields(node.fields, name);
+    }
+    size_t pos = idx->find(node.fields, name);
+    if (pos == node.fields.size() && node.fields_exposed) {
+        // field may have been renamed after the index was built
+        return scan_fields(node.fields, name);
+    }
+    return pos;
+}
+
 const std::vector<field> empty_object{};
 const std::vector<value> empty_array{};
+const std::vector<int64_t> empty_integers{};
+const std::vector<double> empty_reals{};
 const std::string empty_string{};
 const value null_value{};
 
+json_exception not_string_error(const value& val, const std::string& context) {
+    return json_exception(TRACEMSG("Cannot access string" +
+            " from target value: [" + val.dumps() + "]," +
+            " context: [" + context + "]"));
+}
+
+json_exception empty_string_error(const std::string& context) {
+    return json_exception(TRACEMSG("Specified string value is empty" +
+            " context: [" + context + "]"));
+}
+
 } // namespace
 
 value::~value() STATICLIB_NOEXCEPT {
-    switch (this->value_type) {
-    case type::nullt: break;
-    case type::object: delete this->object_val;
-        break;
-    case type::array: delete this->array_val;
-        break;
-    case type::string: delete this->string_val;
-        break;
-    case type::integer: break;
-    case type::real: break;
-    case type::boolean: break;
-    }
+    release_node();
 }
 
 value::value(value&& other) STATICLIB_NOEXCEPT {
@@ -63,7 +399,10 @@ value::value(value&& other) STATICLIB_NOEXCEPT {
         break;
     case type::array: this->array_val = other.array_val;
         break;
-    case type::string: this->string_val = other.string_val;
+    case type::string:
+        // inline data, borrowed length and the string word are copied as is
+        std::memcpy(this->string_head, other.string_head, sizeof(this->string_head));
+        init_string_word(this->string_slot, string_word(other.string_slot).load(std::memory_order_relaxed));
         break;
     case type::integer: this->integer_val = other.integer_val;
         break;
@@ -73,24 +412,15 @@ value::value(value&& other) STATICLIB_NOEXCEPT {
         break;
     }
     this->value_type = other.value_type;
+    this->string_info = other.string_info;
     // moved from object is empty now
     other.value_type = type::nullt;
+    other.string_info = 0;
 }
 
 value& value::operator=(value&& other) STATICLIB_NOEXCEPT {
     // destroy existing value
-    switch (this->value_type) {
-    case type::nullt: break;
-    case type::object: delete this->object_val;
-        break;
-    case type::array: delete this->array_val;
-        break;
-    case type::string: delete this->string_val;
-        break;
-    case type::integer: break;
-    case type::real: break;
-    case type::boolean: break;
-    }
+    release_node();
     // assign new value
     switch (other.value_type) {
     case type::nullt: this->null_val = other.null_val;
@@ -99,7 +429,10 @@ value& value::operator=(value&& other) STATICLIB_NOEXCEPT {
         break;
     case type::array: this->array_val = other.array_val;
         break;
-    case type::string: this->string_val = other.string_val;
+    case type::string:
+        // inline data, borrowed length and the string word are copied as is
+        std::memcpy(this->string_head, other.string_head, sizeof(this->string_head));
+        init_string_word(this->string_slot, string_word(other.string_slot).load(std::memory_order_relaxed));
         break;
     case type::integer: this->integer_val = other.integer_val;
         break;
@@ -109,11 +442,49 @@ value& value::operator=(value&& other) STATICLIB_NOEXCEPT {
         break;
     }
     this->value_type = other.value_type;
+    this->string_info = other.string_info;
     // moved from object is empty now
     other.value_type = type::nullt;
+    other.string_info = 0;
     return *this;
 }
 
+value value::borrowed_string(sl::io::span<const char> data) {
+    if (data.size() > std::numeric_limits<uint32_t>::max()) {
+        return value(std::string(data.data(), data.size()));
+    }
+    value res;
+    res.value_type = type::string;
+    auto ptr = reinterpret_cast<uintptr_t> (data.data());
+    res.string_info = static_cast<uint8_t> (string_borrowed | (ptr & 1));
+    uint32_t len = static_cast<uint32_t> (data.size());
+    std::memcpy(res.string_head + borrowed_length_offset, std::addressof(len), sizeof(len));
+    init_string_word(res.string_slot, ptr);
+    return res;
+}
+
+value value::packed_int64_array(std::vector<int64_t>&& numbers) {
+    auto packed = std::unique_ptr<detail_value::packed_numbers>(
+            new detail_value::packed_numbers(std::move(numbers)));
+    value res;
+    res.array_val = new detail_value::array_node(std::move(packed));
+    res.value_type = type::array;
+    return res;
+}
+
+value value::packed_double_array(std::vector<double>&& numbers) {
+    auto packed = std::unique_ptr<detail_value::packed_numbers>(
+            new detail_value::packed_numbers(std::move(numbers)));
+    value res;
+    res.array_val = new detail_value::array_node(std::move(packed));
+    res.value_type = type::array;
+    return res;
+}
+
+void value::set_object_index_threshold(size_t fields_count) {
+    object_index_threshold.store(fields_count, std::memory_order_relaxed);
+}
+
 value::value() :
 value_type(type::nullt) { }
 
@@ -124,42 +495,43 @@ value_type(type::nullt) {
 
 value::value(std::vector<field>&& object_value) :
 value_type(type::object) {
-    // allocate empty vector and move data into it
-    this->object_val = new std::vector<field>();
-    *(this->object_val) = std::move(object_value);
+    this->object_val = new detail_value::object_node(std::move(object_value));
 }
 
 value::value(const std::initializer_list<field>& object_value) :
 value_type(type::object) {
-    this->object_val = new std::vector<field>();
+    auto vec = std::vector<field>();
+    // elements are temporaries, sharing their nodes is cheaper than copying
     for (auto& a : object_value) {
-        this->object_val->emplace_back(a.name(), a.val().clone());
+        vec.emplace_back(a.clone_shared());
     }
+    this->object_val = new detail_value::object_node(std::move(vec));
 }
 
 value::value(std::vector<value>&& array_value) :
 value_type(type::array) {
-    // allocate empty vector and move data into it
-    this->array_val = new std::vector<value>();
-    *(this->array_val) = std::move(array_value);
+    this->array_val = new detail_value::array_node(std::move(array_value));
 }
 
 value::value(const std::string& string_value) :
 value_type(type::string) {
-    std::string copy(string_value.data(), string_value.length());
-    this->string_val = new std::string();
-    *(this->string_val) = std::move(copy);
+    init_string(string_value.data(), string_value.length());
 }
 
 value::value(std::string&& string_value) :
 value_type(type::string) {
-    this->string_val = new std::string();
-    *(this->string_val) = std::move(string_value);
+    if (string_value.length() <= inline_string_max) {
+        init_string(string_value.data(), string_value.length());
+    } else {
+        auto str = new std::string(std::move(string_value));
+        init_string_word(this->string_slot, reinterpret_cast<uintptr_t> (str));
+        this->string_info = string_heap;
+    }
 }
 
 value::value(const char* string_value) :
 value_type(type::string) {
-    this->string_val = new std::string(string_value);
+    init_string(string_value, std::strlen(string_value));
 }
 
 value::value(int32_t integer_value) :
@@ -194,12 +566,20 @@ value(static_cast<double> (real_value)) { }
 value::value(bool boolean_value) :
 value_type(type::boolean), boolean_val(boolean_value) { }
 
-void value::dump(std::streambuf* dest) const {
-    jansson_dump_to_streambuf(*this, dest);
+void value::dump(std::streambuf* dest, const dump_options& options) const {
+    dump_to_streambuf(*this, dest, options);
+}
+
+std::string value::dumps(const dump_options& options) const {
+    return dump_to_string(*this, options);
 }
 
-std::string value::dumps() const {
-    return jansson_dump_to_string(*this);
+size_t value::dump_to(sl::io::span<char> dest, const dump_options& options) const {
+    return dump_to_span(*this, dest, options);
+}
+
+size_t value::serialized_size(const dump_options& options) const {
+    return dump_size(*this, options);
 }
 
 value value::clone() const {
@@ -208,22 +588,34 @@ value value::clone() const {
     case type::object:
     {
         auto vec = std::vector<field>();
-        vec.reserve(object_val->size());
-        for (const field& fi : *object_val) {
-            vec.emplace_back(fi.name(), fi.val().clone());
+        vec.reserve(object_val->fields.size());
+        for (const field& fi : object_val->fields) {
+            vec.emplace_back(fi.clone());
         }
         return value(std::move(vec));
     }
     case type::array:
     {
+        if (nullptr != array_val->packed) {
+            value res;
+            res.array_val = new detail_value::array_node(array_val->packed->copy());
+            res.value_type = type::array;
+            return res;
+        }
         auto vec = std::vector<value>();
-        vec.reserve(array_val->size());
-        for (const value& va : *array_val) {
+        vec.reserve(array_val->values.size());
+        for (const value& va : array_val->values) {
             vec.emplace_back(va.clone());
         }
         return value(std::move(vec));
     }
-    case type::string: return value(*string_val);
+    case type::string: {
+        auto span = as_string_span();
+        value res;
+        res.value_type = type::string;
+        res.init_string(span.data(), span.size());
+        return res;
+    }
     case type::integer: return value(integer_val);
     case type::real: return value(real_val);
     case type::boolean: return value(boolean_val);
@@ -231,14 +623,42 @@ value value::clone() const {
     }
 }
 
+value value::clone_shared() const {
+    value res;
+    switch (value_type) {
+    case type::object:
+        if (object_val->exposed) {
+            // may be changed through the reference handed out earlier
+            res.object_val = copy_node(*object_val);
+        } else {
+            object_val->refs.fetch_add(1, std::memory_order_relaxed);
+            res.object_val = object_val;
+        }
+        break;
+    case type::array:
+        if (array_val->exposed) {
+            res.array_val = copy_node(*array_val);
+        } else {
+            array_val->refs.fetch_add(1, std::memory_order_relaxed);
+            res.array_val = array_val;
+        }
+        break;
+    default:
+        return clone();
+    }
+    res.value_type = value_type;
+    return res;
+}
+
 type value::json_type() const {
     return this->value_type;
 }
 
 const value& value::getattr(const std::string& name) const {
-    for (auto& el : this->as_object()) {
-        if (name == el.name()) {
-            return el.val();
+    if (type::object == value_type) {
+        size_t pos = find_field(*object_val, name);
+        if (pos < object_val->fields.size()) {
+            return object_val->fields[pos].val();
         }
     }
     return null_value;
@@ -250,14 +670,29 @@ const value& value::operator[](const std::string& name) const {
 
 value& value::getattr_or_throw(const std::string& name, const std::string& context) {
     if (type::object == value_type) {
-        std::vector<field>& obj = this->as_object_or_throw();
-        for (field& el : obj) {
-            if (name == el.name()) {
-                return el.val();
+        unshare_node();
+        object_val->exposed = true;
+        std::vector<field>& obj = object_val->fields;
+        auto idx = object_val->index.load(std::memory_order_relaxed);
+        if (nullptr != idx && !idx->matches(obj)) {
+            // fields were changed, this method has exclusive access
+            object_val->drop_index();
+        }
+        size_t pos = find_field(*object_val, name);
+        if (pos < obj.size()) {
+            idx = object_val->index.load(std::memory_order_relaxed);
+            if (object_val->fields_exposed && nullptr != idx && idx->find(obj, name) != pos) {
+                // index missed renamed field, it is rebuilt on the next lookup
+                object_val->drop_index();
             }
+            return obj[pos].val();
         }
         // add attr
         obj.emplace_back(field(name, value()));
+        idx = object_val->index.load(std::memory_order_relaxed);
+        if (nullptr != idx) {
+            idx->add_last(obj);
+        }
         return obj[obj.size() - 1].val();
     }
     // not object    
@@ -268,18 +703,25 @@ value& value::getattr_or_throw(const std::string& name, const std::string& conte
 
 const std::vector<field>& value::as_object() const {
     if (type::object == value_type) {
-        return *(this->object_val);
+        return this->object_val->fields;
     }
     return empty_object;
 }
 
 std::vector<field>& value::as_object_or_throw(const std::string& context) {
-    return const_cast<std::vector<field>&> (const_cast<const value*> (this)->as_object_or_throw(context));
+    // throws if not object
+    const_cast<const value*> (this)->as_object_or_throw(context);
+    unshare_node();
+    // fields may be changed through the returned reference at any time
+    object_val->drop_index();
+    object_val->fields_exposed = true;
+    object_val->exposed = true;
+    return object_val->fields;
 }
 
 const std::vector<field>& value::as_object_or_throw(const std::string& context) const {
     if (type::object == value_type) {
-        return *(this->object_val);
+        return this->object_val->fields;
     }
     // not object    
     throw json_exception(TRACEMSG("Cannot access object" +
@@ -289,7 +731,12 @@ const std::vector<field>& value::as_object_or_throw(const std::string& context)
 
 bool value::set_object(std::vector<field>&& object_value) {
     if (type::object == value_type) {
-        *(this->object_val) = std::move(object_value);
+        if (is_shared(object_val)) {
+            *this = value(std::move(object_value));
+        } else {
+            this->object_val->fields = std::move(object_value);
+            this->object_val->drop_index();
+        }
         return true;
     }
     *this = value(std::move(object_value));
@@ -298,18 +745,24 @@ bool value::set_object(std::vector<field>&& object_value) {
 
 const std::vector<value>& value::as_array() const {
     if (type::array == value_type) {
-        return *(this->array_val);
+        return array_values(*this->array_val);
     }
     return empty_array;
 }
 
 std::vector<value>& value::as_array_or_throw(const std::string& context) {
-    return const_cast<std::vector<value>&> (const_cast<const value*> (this)->as_array_or_throw(context));
+    // throws if not array
+    const_cast<const value*> (this)->as_array_or_throw(context);
+    unshare_node();
+    // elements may be changed through the returned reference at any time
+    unpack_array(*array_val);
+    array_val->exposed = true;
+    return array_val->values;
 }
 
 const std::vector<value>& value::as_array_or_throw(const std::string& context) const {
     if (type::array == value_type) {
-        return *(this->array_val);
+        return array_values(*this->array_val);
     }
     // not array    
     throw json_exception(TRACEMSG("Cannot access array" +
@@ -319,36 +772,94 @@ const std::vector<value>& value::as_array_or_throw(const std::string& context) c
 
 bool value::set_array(std::vector<value>&& array_value) {
     if (type::array == value_type) {
-        *(this->array_val) = std::move(array_value);
+        if (is_shared(array_val)) {
+            *this = value(std::move(array_value));
+        } else {
+            this->array_val->values = std::move(array_value);
+            this->array_val->packed.reset();
+        }
         return true;
     }
     *this = value(std::move(array_value));
     return false;
 }
 
+bool value::is_array_packed() const {
+    return type::array == value_type && nullptr != array_val->packed;
+}
+
+type value::packed_array_type() const {
+    if (is_array_packed()) {
+        return array_val->packed->kind;
+    }
+    return type::nullt;
+}
+
+sl::io::span<const int64_t> value::as_int64_span() const {
+    if (is_array_packed() && type::integer == array_val->packed->kind) {
+        const std::vector<int64_t>& vec = array_val->packed->integers;
+        return sl::io::span<const int64_t>(vec.data(), vec.size());
+    }
+    return sl::io::span<const int64_t>(empty_integers.data(), empty_integers.size());
+}
+
+sl::io::span<const double> value::as_double_span() const {
+    if (is_array_packed() && type::real == array_val->packed->kind) {
+        const std::vector<double>& vec = array_val->packed->reals;
+        return sl::io::span<const double>(vec.data(), vec.size());
+    }
+    return sl::io::span<const double>(empty_reals.data(), empty_reals.size());
+}
+
 const std::string& value::as_string() const {
     if (type::string == value_type) {
-        return *(this->string_val);
+        return publish_string();
     }
     return empty_string;
 }
 
+sl::io::span<const char> value::as_string_span() const {
+    if (type::string == value_type) {
+        if (string_info <= inline_string_max) {
+            return sl::io::span<const char>(inline_string(), string_info);
+        }
+        auto word = string_word(string_slot).load(std::memory_order_acquire);
+        if (is_borrowed(string_info) && (word & 1) == (string_info & 1)) {
+            uint32_t len = 0;
+            std::memcpy(std::addressof(len), string_head + borrowed_length_offset, sizeof(len));
+            return sl::io::span<const char>(reinterpret_cast<const char*> (word), len);
+        }
+        auto str = published_string();
+        return sl::io::span<const char>(str->data(), str->length());
+    }
+    return sl::io::span<const char>(empty_string.data(), empty_string.length());
+}
+
+bool value::is_string_borrowed() const {
+    return type::string == value_type && is_borrowed(string_info);
+}
+
 std::string& value::as_string_or_throw(const std::string& context) {
-    return const_cast<std::string&> (const_cast<const value*> (this)->as_string_or_throw(context));
+    if (type::string == value_type) {
+        own_string();
+        return *published_string();
+    }
+    throw not_string_error(*this, context);
 }
 
 const std::string& value::as_string_or_throw(const std::string& context) const {
     if (type::string == value_type) {
-        return *(this->string_val);
+        return as_string();
     }
-    // not string    
-    throw json_exception(TRACEMSG("Cannot access string" +
-            " from target value: [" + dumps() + "]," +
-            " context: [" + context + "]"));
+    throw not_string_error(*this, context);
 }
 
 std::string& value::as_string_nonempty_or_throw(const std::string& context) {
-    return const_cast<std::string&> (const_cast<const value*> (this)->as_string_nonempty_or_throw(context));
+    std::string& res = as_string_or_throw(context);
+    if (!res.empty()) {
+        return res;
+    }
+    throw empty_string_error(context);
 }
 
 const std::string& value::as_string_nonempty_or_throw(const std::string& context) const {
@@ -356,14 +867,12 @@ const std::string& value::as_string_nonempty_or_throw(const std::string& context
     if (!res.empty()) {
         return res;
     }
-    // empty
-    throw json_exception(TRACEMSG("Specified string value is empty" +
-            " context: [" + context + "]"));
+    throw empty_string_error(context);
 }
 
 const std::string& value::as_string(const std::string& default_val) const {
     if (type::string == value_type) {
-        return *(this->string_val);
+        return as_string();
     }
     return default_val;
 }
@@ -375,7 +884,11 @@ bool value::set_string(const std::string& string_value) {
 
 bool value::set_string(std::string&& string_value) {
     if (type::string == value_type) {
-        *(this->string_val) = std::move(string_value);
+        if (string_heap == string_info) {
+            *published_string() = std::move(string_value);
+        } else {
+            *this = value(std::move(string_value));
+        }
         return true;
     }
     *this = value(std::move(string_value));
@@ -724,5 +1237,103 @@ bool value::set_bool(bool bool_value) {
     return false;
 }
 
+void value::release_node() STATICLIB_NOEXCEPT {
+    switch (this->value_type) {
+    case type::nullt: break;
+    case type::object:
+        release_shared(this->object_val);
+        break;
+    case type::array:
+        release_shared(this->array_val);
+        break;
+    case type::string:
+        delete published_string();
+        break;
+    case type::integer: break;
+    case type::real: break;
+    case type::boolean: break;
+    }
+}
+
+void value::unshare_node() {
+    switch (this->value_type) {
+    case type::object:
+        if (is_shared(this->object_val)) {
+            auto node = copy_node(*this->object_val);
+            release_shared(this->object_val);
+            this->object_val = node;
+        }
+        break;
+    case type::array:
+        if (is_shared(this->array_val)) {
+            auto node = copy_node(*this->array_val);
+            release_shared(this->array_val);
+            this->array_val = node;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void value::init_string(const char* data, size_t len) {
+    if (len <= inline_string_max) {
+        std::memcpy(this->string_head, data, len);
+        init_string_word(this->string_slot, 0);
+        this->string_info = static_cast<uint8_t> (len);
+    } else {
+        auto str = new std::string(data, len);
+        init_string_word(this->string_slot, reinterpret_cast<uintptr_t> (str));
+        this->string_info = string_heap;
+    }
+}
+
+const char* value::inline_string() const {
+    static_assert(16 == sizeof(value), "Invalid value size");
+    static_assert(sizeof(string_head) == inline_string_max, "Invalid inline string layout");
+    return string_head;
+}
+
+std::string* value::published_string() const {
+    auto word = string_word(string_slot).load(std::memory_order_acquire);
+    if (is_borrowed(string_info)) {
+        if ((word & 1) == (string_info & 1)) {
+            // still the borrowed pointer
+            return nullptr;
+        }
+        word &= ~static_cast<uintptr_t> (1);
+    }
+    return reinterpret_cast<std::string*> (word);
+}
+
+const std::string& value::publish_string() const {
+    auto existing = published_string();
+    if (nullptr != existing) {
+        return *existing;
+    }
+    auto span = as_string_span();
+    auto created = std::unique_ptr<std::string>(new std::string(span.data(), span.size()));
+    auto expected = static_cast<uintptr_t> (0);
+    auto desired = reinterpret_cast<uintptr_t> (created.get());
+    if (is_borrowed(string_info)) {
+        expected = reinterpret_cast<uintptr_t> (span.data());
+        desired |= static_cast<uintptr_t> (~string_info & 1);
+    }
+    if (string_word(string_slot).compare_exchange_strong(expected, desired, std::memory_order_acq_rel)) {
+        return *created.release();
+    }
+    // published by another thread
+    return *published_string();
+}
+
+void value::own_string() {
+    if (string_heap != this->string_info) {
+        // published string (created now if necessary) becomes the heap one
+        auto str = const_cast<std::string*> (std::addressof(publish_string()));
+        string_word(this->string_slot).store(reinterpret_cast<uintptr_t> (str), std::memory_order_relaxed);
+        this->string_info = string_heap;
+    }
+}
+
 }
 } // namespace
@@ -1,5 +1,5 @@
 /*
- * Copyright 2015, alex at staticlibs.net
+ * Copyright 2026, alex at staticlibs.net
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,28 +14,31 @@
  * limitations under the License.
  */
 
-/* 
- * File:   jansson_deleter.hpp
+/*
+ * File:   writer.cpp
  * Author: alex
  *
- * Created on April 9, 2017, 8:28 PM
+ * Created on October 21, 2026, 4:10 PM
  */
 
-#ifndef STATICLIB_JSON_JANSSON_DELETER_HPP
-#define STATICLIB_JSON_JANSSON_DELETER_HPP
+#include "staticlib/json/writer.hpp"
+
+#include "dump_ops.hpp"
 
 namespace staticlib {
 namespace json {
+namespace detail_writer {
 
-class jansson_deleter {
-public:
-    void operator()(json_t* json) {
-        json_decref(json);
-    }
-};
-
-} // namespace
+void dump_key(output& out, const std::string& name, const dump_options& options) {
+    detail_dump::serializer<output> ser(out, options);
+    ser.dump_key(name);
 }
 
-#endif /* STATICLIB_JSON_JANSSON_DELETER_HPP */
+void dump_value(output& out, const value& val, const dump_options& options, size_t depth) {
+    detail_dump::serializer<output> ser(out, options);
+    ser.dump(val, depth);
+}
 
+} // namespace
+}
+} // namespace
@@ -0,0 +1,88 @@
+/*
+ * File:   array_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:48 PM
+ */
+
+#include "staticlib/json/array_reader.hpp"
+
+#include <iostream>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/array_writer.hpp"
+#include "staticlib/json/field.hpp"
+
+void test_empty() {
+    auto rd = sl::json::make_array_reader(sl::io::span<const char>("[\n\n]\n"));
+    slassert(!rd.has_next());
+    slassert(!rd.has_next());
+}
+
+void test_roundtrip() {
+    auto sink = sl::io::string_sink();
+    {
+        auto writer = sl::json::make_array_writer(sink);
+        for (int i = 0; i < 1000; i++) {
+            writer.write({
+                {"idx", i},
+                {"name", "foo"}
+            });
+        }
+    }
+    auto src = sl::io::string_source(sink.get_string());
+    auto rd = sl::json::make_array_reader(src);
+    int count = 0;
+    while (rd.has_next()) {
+        auto entry = rd.next();
+        slassert(count == entry["idx"].as_int64());
+        slassert("foo" == entry["name"].as_string());
+        count += 1;
+    }
+    slassert(1000 == count);
+}
+
+void test_errors() {
+    bool thrown = false;
+    try {
+        auto rd = sl::json::make_array_reader(sl::io::span<const char>("{}"));
+        rd.has_next();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        auto rd = sl::json::make_array_reader(sl::io::span<const char>("[1, 2 3]"));
+        while (rd.has_next()) {
+            rd.next();
+        }
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        auto rd = sl::json::make_array_reader(sl::io::span<const char>("[1,]"));
+        while (rd.has_next()) {
+            rd.next();
+        }
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_empty();
+        test_roundtrip();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
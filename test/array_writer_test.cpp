@@ -48,11 +48,26 @@ void test_multiple() {
     slassert(std::string::npos != sink.get_string().find(','));
 }
 
+void test_options() {
+    auto sink = sl::io::string_sink();
+    {
+        auto writer = sl::json::make_array_writer(sink, sl::json::dump_options::compact_output());
+        writer.write({
+            {"foo", 42}
+        });
+        writer.write({
+            {"bar", "baz"}
+        });
+    }
+    slassert("[{\"foo\":42},{\"bar\":\"baz\"}]" == sink.get_string());
+}
+
 int main() {
     try {
         test_empty();
         test_one();
         test_multiple();
+        test_options();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   document_test.cpp
+ * Author: alex
+ *
+ * Created on October 20, 2026, 5:10 PM
+ */
+
+#include "staticlib/json/document.hpp"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/json/operations.hpp"
+
+const std::string test_json = R"({
+    "id": 42,
+    "name": "foo\nbar",
+    "ratio": 0.5,
+    "enabled": true,
+    "disabled": false,
+    "nothing": null,
+    "min": -9223372036854775808,
+    "list": [1, "two", [3], {"four": 4}, []],
+    "empty": {},
+    "esc\"aped": "yes"
+} trailing data)";
+
+bool throws_exc(std::function<void()> fun) {
+    try {
+        fun();
+    } catch (const sl::json::json_exception& e) {
+        (void) e;
+        return true;
+    }
+    return false;
+}
+
+void test_access() {
+    auto doc = sl::json::document({test_json.data(), test_json.length()});
+    slassert(sl::json::type::object == doc.root().json_type());
+    slassert(10 == doc.root().size());
+    slassert(42 == doc["id"].as_int64_or_throw());
+    slassert("foo\nbar" == doc["name"].as_string_or_throw());
+    slassert(7 == doc["name"].as_string_span().size());
+    slassert(0.5 == doc["ratio"].as_double_or_throw());
+    slassert(doc["enabled"].as_bool_or_throw());
+    slassert(!doc["disabled"].as_bool_or_throw());
+    slassert(sl::json::type::boolean == doc["disabled"].json_type());
+    slassert(sl::json::type::nullt == doc["nothing"].json_type());
+    slassert(std::numeric_limits<int64_t>::min() == doc["min"].as_int64());
+    slassert("yes" == doc["esc\"aped"].as_string());
+    auto list = doc["list"];
+    slassert(5 == list.size());
+    slassert(1 == list.at(0).as_int64());
+    slassert("two" == list.at(1).as_string());
+    slassert(3 == list.at(2).at(0).as_int64());
+    slassert(4 == list.at(3)["four"].as_int64());
+    slassert(0 == list.at(4).size());
+    slassert(0 == doc["empty"].size());
+}
+
+void test_iterate() {
+    auto doc = sl::json::document({test_json.data(), test_json.length()});
+    auto names = std::vector<std::string>();
+    for (auto fi : doc.root().as_object()) {
+        names.push_back(fi.name());
+    }
+    slassert(10 == names.size());
+    slassert("id" == names[0]);
+    slassert("esc\"aped" == names[9]);
+    size_t count = 0;
+    for (auto el : doc["list"].as_array()) {
+        (void) el;
+        count += 1;
+    }
+    slassert(5 == count);
+    for (auto el : doc["id"].as_array()) {
+        (void) el;
+        slassert(false);
+    }
+    for (auto fi : doc["missing"].as_object()) {
+        (void) fi;
+        slassert(false);
+    }
+}
+
+void test_missing() {
+    auto doc = sl::json::document({test_json.data(), test_json.length()});
+    slassert(sl::json::type::nullt == doc["missing"].json_type());
+    slassert(sl::json::type::nullt == doc["missing"]["foo"].json_type());
+    slassert(sl::json::type::nullt == doc["list"].at(42).json_type());
+    slassert(0 == doc["id"].as_string_span().size());
+    slassert("" == doc["missing"].as_string());
+    slassert(0 == doc["name"].as_int64());
+    slassert(0 == doc["missing"].as_double());
+    slassert(!doc["id"].as_bool());
+    slassert(throws_exc([&doc] { doc["id"].as_string_or_throw(); }));
+    slassert(throws_exc([&doc] { doc["name"].as_int64_or_throw(); }));
+    slassert(throws_exc([&doc] { doc["id"].as_double_or_throw(); }));
+    slassert(throws_exc([&doc] { doc["id"].as_bool_or_throw(); }));
+}
+
+void test_to_value() {
+    auto doc = sl::json::document({test_json.data(), test_json.length()});
+    auto val = sl::json::loads(test_json);
+    slassert(val.dumps() == doc.root().to_value().dumps());
+    slassert(val["list"].dumps() == doc["list"].to_value().dumps());
+    // moved
+    auto moved = std::move(doc);
+    slassert(42 == moved["id"].as_int64());
+}
+
+void test_scalar() {
+    auto str = std::string("\"foo\"");
+    auto doc = sl::json::document({str.data(), str.length()});
+    slassert(1 == doc.tape_size());
+    slassert("foo" == doc.root().as_string());
+    slassert(0 == doc.root().size());
+    auto src = sl::io::string_source("[1, 2.5]");
+    auto from_source = sl::json::make_document(src);
+    slassert(2.5 == from_source.root().at(1).as_double());
+    slassert(5 == from_source.tape_size());
+}
+
+void test_errors() {
+    slassert(throws_exc([] { sl::json::document(sl::io::span<const char>("")); }));
+    slassert(throws_exc([] { sl::json::document(sl::io::span<const char>("[1, 2")); }));
+    slassert(throws_exc([] { sl::json::document(sl::io::span<const char>("{\"foo\" 1}")); }));
+}
+
+int main() {
+    try {
+        test_access();
+        test_iterate();
+        test_missing();
+        test_to_value();
+        test_scalar();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include "staticlib/json/field.hpp"
 
 #include <iostream>
+#include <memory>
 
 #include "staticlib/config/assert.hpp"
 
@@ -33,9 +34,27 @@ void test_string() {
     slassert("bar" == fi.val().as_string());
 }
 
+void test_name() {
+    // name that is not interned is stored in the field
+    sl::json::field fi{"foo", 42};
+    slassert(!fi.is_name_interned());
+    auto cl = fi.clone();
+    slassert("foo" == cl.name());
+    slassert(!cl.is_name_interned());
+    auto& self = fi;
+    fi = std::move(self);
+    slassert("foo" == fi.name());
+    slassert(42 == fi.as_int64());
+    auto moved = std::move(fi);
+    slassert("foo" == moved.name());
+    slassert("" == fi.name());
+    slassert("" == sl::json::field().name());
+}
+
 int main() {
     try {
         test_string();
+        test_name();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   key_pool_test.cpp
+ * Author: alex
+ *
+ * Created on October 20, 2026, 12:15 PM
+ */
+
+#include "staticlib/json/key_pool.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/json/operations.hpp"
+
+const std::string test_json = R"([
+    {"identifier_of_the_record": 1, "name": "foo"},
+    {"identifier_of_the_record": 2, "name": "bar"},
+    {"name": "baz", "identifier_of_the_record": 3, "extra": {"name": null}}
+])";
+
+void test_intern() {
+    sl::json::key_pool pool;
+    auto& foo = pool.intern("foo");
+    slassert("foo" == foo);
+    slassert(std::addressof(foo) == std::addressof(pool.intern(std::string("foo"))));
+    slassert(std::addressof(foo) != std::addressof(pool.intern("bar")));
+    slassert(2 == pool.size());
+    auto fi = pool.make_field("foo", 42);
+    slassert(fi.is_name_interned());
+    slassert(std::addressof(foo) == std::addressof(fi.name()));
+    slassert(42 == fi.as_int64());
+    slassert(!sl::json::field("foo", 42).is_name_interned());
+}
+
+void test_load() {
+    auto val = sl::json::value();
+    auto pool = std::unique_ptr<sl::json::key_pool>(new sl::json::key_pool());
+    val = sl::json::load({test_json.data(), test_json.length()}, *pool);
+    slassert(sl::json::loads(test_json).dumps() == val.dumps());
+    slassert(3 == pool->size());
+    auto& arr = val.as_array();
+    auto& name = pool->intern("name");
+    slassert(std::addressof(name) == std::addressof(arr[0].as_object()[1].name()));
+    slassert(std::addressof(name) == std::addressof(arr[2].as_object()[0].name()));
+    slassert(std::addressof(name) == std::addressof(arr[2]["extra"].as_object()[0].name()));
+    slassert("bar" == arr[1][name].as_string());
+    slassert(3 == arr[2]["identifier_of_the_record"].as_int64());
+    // clone shares names
+    auto copy = val.clone();
+    slassert(std::addressof(name) == std::addressof(copy.as_array()[0].as_object()[1].name()));
+    // names outlive the pool
+    pool.reset();
+    slassert("name" == copy.as_array()[0].as_object()[1].name());
+    slassert("foo" == val.as_array()[0]["name"].as_string());
+    auto moved = std::move(val.as_array_or_throw()[0].as_object_or_throw()[1]);
+    slassert("name" == moved.name());
+    slassert(moved.is_name_interned());
+    moved = sl::json::field("other", 43);
+    slassert(!moved.is_name_interned());
+    slassert("other" == moved.name());
+}
+
+void test_duplicates() {
+    sl::json::key_pool pool;
+    bool thrown = false;
+    try {
+        auto json = std::string("{\"foo\": 1, \"foo\": 2}");
+        sl::json::load({json.data(), json.length()}, pool);
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_intern();
+        test_load();
+        test_duplicates();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
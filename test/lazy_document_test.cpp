@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   lazy_document_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:10 PM
+ */
+
+#include "staticlib/json/lazy_document.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/json/field.hpp"
+
+const std::string test_json = R"({
+    "skipped": {"foo": [1, 2, {"bar": "b}a]z"}], "empty": []},
+    "id": 42,
+    "name": "foo\nbar",
+    "ratio": 0.5,
+    "enabled": true,
+    "nothing": null,
+    "list": [1, "two", [3], {"four": 4}],
+    "esc\"aped": "yes",
+    "broken": "\ud83d"
+} trailing data)";
+
+bool throws_exc(std::function<void()> fun) {
+    try {
+        fun();
+    } catch (const sl::json::json_exception& e) {
+        (void) e;
+        return true;
+    }
+    return false;
+}
+
+void test_access() {
+    auto doc = sl::json::lazy_document({test_json.data(), test_json.length()});
+    slassert(sl::json::type::object == doc.root().json_type());
+    slassert(9 == doc.root().size());
+    slassert(42 == doc["id"].as_int64());
+    slassert(sl::json::type::integer == doc["id"].json_type());
+    slassert("foo\nbar" == doc["name"].as_string());
+    slassert(0.5 == doc["ratio"].as_double());
+    slassert(sl::json::type::real == doc["ratio"].json_type());
+    slassert(doc["enabled"].as_bool());
+    slassert(sl::json::type::nullt == doc["nothing"].json_type());
+    slassert("yes" == doc["esc\"aped"].as_string());
+    slassert("b}a]z" == doc["skipped"]["foo"].at(2)["bar"].as_string());
+    auto list = doc["list"];
+    slassert(4 == list.size());
+    slassert("two" == list.at(1).as_string());
+    slassert(3 == list.at(2).at(0).as_int64());
+    slassert(4 == list.at(3)["four"].as_int64());
+    slassert(sl::json::type::nullt == list.at(4).json_type());
+    auto keys = doc.root().keys();
+    slassert(9 == keys.size());
+    slassert("esc\"aped" == keys[7]);
+}
+
+void test_missing() {
+    auto doc = sl::json::lazy_document({test_json.data(), test_json.length()});
+    slassert(sl::json::type::nullt == doc["foo"].json_type());
+    slassert(sl::json::type::nullt == doc["foo"]["bar"].json_type());
+    slassert("" == doc["id"].as_string());
+    slassert(0 == doc["name"].as_int64());
+    slassert(throws_exc([&doc] { doc["name"].as_int64_or_throw(); }));
+    slassert(sl::json::type::nullt == doc["skipped"]["empty"].at(0).json_type());
+}
+
+void test_to_value() {
+    auto doc = sl::json::lazy_document({test_json.data(), test_json.length()});
+    auto val = doc["skipped"].to_value();
+    slassert(2 == val.as_object().size());
+    slassert("b}a]z" == val["foo"].as_array()[2]["bar"].as_string());
+    // broken field is not decoded until accessed
+    slassert(throws_exc([&doc] { doc["broken"].as_string(); }));
+    slassert(throws_exc([&doc] { doc.root().to_value(); }));
+}
+
+void test_scalar() {
+    auto str = std::string(" 42 ");
+    auto doc = sl::json::lazy_document({str.data(), str.length()});
+    slassert(42 == doc.root().as_int64());
+    slassert(sl::json::type::nullt == doc["foo"].json_type());
+}
+
+void test_errors() {
+    slassert(throws_exc([] { sl::json::lazy_document(sl::io::span<const char>("")); }));
+    slassert(throws_exc([] { sl::json::lazy_document(sl::io::span<const char>("{\"foo\": [1, 2}")); }));
+    slassert(throws_exc([] { sl::json::lazy_document(sl::io::span<const char>("[\"foo]")); }));
+    slassert(throws_exc([] { sl::json::lazy_document(sl::io::span<const char>("[[1]")); }));
+    slassert(throws_exc([] {
+        auto doc = sl::json::lazy_document(sl::io::span<const char>("{\"foo\" 1}"));
+        doc["foo"];
+    }));
+}
+
+int main() {
+    try {
+        test_access();
+        test_missing();
+        test_to_value();
+        test_scalar();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
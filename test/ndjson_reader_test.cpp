@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   ndjson_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:40 PM
+ */
+
+#include "staticlib/json/ndjson_reader.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+void test_records() {
+    auto str = std::string("{\"id\": 1, \"msg\": \"foo\"}\n"
+            "{\"id\": 2, \"msg\": \"bar\"}\r\n"
+            "\n"
+            "  [3]  \n"
+            "42\n"
+            "true");
+    auto src = sl::io::array_source(str.data(), str.size());
+    auto rd = sl::json::make_ndjson_reader(src);
+    slassert(rd.has_next());
+    slassert("foo" == rd.next()["msg"].as_string());
+    slassert(rd.has_next());
+    slassert(2 == rd.next()["id"].as_int64());
+    slassert(3 == rd.next().as_array()[0].as_int64());
+    slassert(42 == rd.next().as_int64());
+    slassert(rd.next().as_bool());
+    slassert(!rd.has_next());
+    slassert(5 == rd.records_count());
+}
+
+void test_large() {
+    std::string str;
+    for (int i = 0; i < 10000; i++) {
+        str += "{\"idx\": " + sl::support::to_string(i) + "}\n";
+    }
+    auto rd = sl::json::make_ndjson_reader(sl::io::string_source(std::move(str)));
+    int64_t sum = 0;
+    while (rd.has_next()) {
+        sum += rd.next()["idx"].as_int64();
+    }
+    slassert(10000 == rd.records_count());
+    slassert(49995000 == sum);
+}
+
+void test_errors() {
+    bool thrown = false;
+    try {
+        auto rd = sl::json::make_ndjson_reader(sl::io::span<const char>("{} {}\n"));
+        rd.next();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        auto rd = sl::json::make_ndjson_reader(sl::io::span<const char>("{}\n{\"foo\": \n"));
+        while (rd.has_next()) {
+            rd.next();
+        }
+    } catch (const sl::json::json_exception& e) {
+        slassert(std::string::npos != std::string(e.what()).find("line: [3]"));
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_records();
+        test_large();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include "staticlib/json/operations.hpp"
 
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -162,6 +163,392 @@ void test_dumps_short() {
     slassert("\"foo\"" == sl::json::dumps("foo"));
 }
 
+void test_dump_scalars() {
+    slassert("null" == sl::json::dumps(nullptr));
+    slassert("true" == sl::json::dumps(true));
+    slassert("false" == sl::json::dumps(false));
+    slassert("42" == sl::json::dumps(42));
+    slassert("-9223372036854775808" == sl::json::dumps(std::numeric_limits<int64_t>::min()));
+    slassert("42.0" == sl::json::dumps(42.0));
+    slassert("-0.5" == sl::json::dumps(-0.5));
+    slassert("1e100" == sl::json::dumps(1e100));
+    slassert("1e-5" == sl::json::dumps(1e-5));
+    slassert("9223372036854775807" == sl::json::dumps(std::numeric_limits<int64_t>::max()));
+    slassert("-7" == sl::json::dumps(-7));
+    // shortest round-trip digits
+    slassert("0.1" == sl::json::dumps(0.1));
+    slassert("0.30000000000000004" == sl::json::dumps(0.1 + 0.2));
+    slassert("1.5e-7" == sl::json::dumps(1.5e-7));
+    slassert("0.0001" == sl::json::dumps(1e-4));
+    slassert("10000000000000000.0" == sl::json::dumps(1e16));
+    slassert("1.2345678901234568e17" == sl::json::dumps(123456789012345678.0));
+    slassert("5e-324" == sl::json::dumps(std::numeric_limits<double>::denorm_min()));
+    slassert("1.7976931348623157e308" == sl::json::dumps(std::numeric_limits<double>::max()));
+    slassert("-0.0" == sl::json::dumps(-0.0));
+    slassert(0.1 + 0.2 == sl::json::loads(sl::json::dumps(0.1 + 0.2)).as_double());
+    slassert("{}" == sl::json::dumps(sl::json::value(std::vector<sl::json::field>())));
+    slassert("[]" == sl::json::dumps(sl::json::value(std::vector<sl::json::value>())));
+}
+
+void test_dump_escapes() {
+    slassert("\"a\\\"b\\\\c/d\\b\\f\\n\\r\\t\\u001F\"" == sl::json::dumps("a\"b\\c/d\b\f\n\r\t\x1f"));
+    slassert("\"\xd0\x96\xf0\x9f\x98\x80\"" == sl::json::dumps("\xd0\x96\xf0\x9f\x98\x80"));
+    bool thrown = false;
+    try {
+        sl::json::dumps("\xd0");
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        sl::json::dumps(std::numeric_limits<double>::infinity());
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+// reference implementation, checks one sequence at a time
+const char* find_utf8_invalid_bytewise(const char* pos, const char* end) {
+    while (pos < end) {
+        unsigned char ch = static_cast<unsigned char> (*pos);
+        size_t len = ch < 0x80 ? 1 : sl::json::detail_parser::utf8_sequence_length(ch);
+        if (0 == len || static_cast<size_t> (end - pos) < len || (len > 1 &&
+                !sl::json::detail_parser::utf8_sequence_valid(reinterpret_cast<const unsigned char*> (pos), len))) {
+            return pos;
+        }
+        pos += len;
+    }
+    return end;
+}
+
+// checks dumped string or the position of invalid UTF-8 reported
+void check_dump_utf8(const std::string& str) {
+    const char* begin = str.data();
+    const char* end = begin + str.length();
+    const char* invalid = find_utf8_invalid_bytewise(begin, end);
+    if (end == invalid) {
+        slassert("\"" + str + "\"" == sl::json::dumps(str));
+        return;
+    }
+    bool thrown = false;
+    try {
+        sl::json::dumps(str);
+    } catch (const sl::json::json_exception& e) {
+        auto pos = "position: [" + sl::support::to_string(static_cast<size_t> (invalid - begin)) + "]";
+        slassert(std::string(e.what()).find(pos) != std::string::npos);
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_dump_scan() {
+    // escaped byte at every position of every block
+    for (size_t len = 0; len < 80; len++) {
+        for (size_t idx = 0; idx <= len; idx++) {
+            std::string str(len, 'a');
+            std::string expected = "\"" + str + "\"";
+            if (idx < len) {
+                str[idx] = idx % 3 ? '"' : (idx % 2 ? '\\' : '\x1f');
+                std::string esc = idx % 3 ? "\\\"" : (idx % 2 ? "\\\\" : "\\u001F");
+                expected = "\"" + str.substr(0, idx) + esc + str.substr(idx + 1) + "\"";
+            }
+            slassert(expected == sl::json::dumps(str));
+        }
+    }
+    // valid and broken sequences at every position
+    const char* seqs[] = {
+        "a", "\xd0\x96", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf", "\xef\xbf\xbf",
+        "\x80", "\xc0\xaf", "\xc1\xbf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf0\x80\x80\xaf", "\xf4\x90\x80\x80",
+        "\xf5\x80\x80\x80", "\xff", "\xd0", "\xe2\x82", "\xf0\x9f\x98", "\xd0\x96\x96", "\xe2\x82\xac\xac"
+    };
+    uint32_t rnd = 42;
+    for (size_t round = 0; round < 20000; round++) {
+        std::string str;
+        size_t count = round % 40;
+        for (size_t i = 0; i < count; i++) {
+            rnd = rnd * 1103515245 + 12345;
+            // mostly valid data
+            size_t idx = (rnd >> 16) % 100;
+            str.append(seqs[idx < 94 ? idx % 6 : idx - 88 + (idx % 2) * 6]);
+        }
+        check_dump_utf8(str);
+    }
+    for (const char* seq : seqs) {
+        for (size_t pad = 0; pad < 70; pad++) {
+            check_dump_utf8(std::string(pad, 'a') + seq + std::string(pad % 7, 'b'));
+        }
+    }
+}
+
+void test_dump_streambuf() {
+    auto vec = std::vector<sl::json::value>();
+    for (int i = 0; i < 1000; i++) {
+        vec.emplace_back(std::string(i, 'a'));
+    }
+    auto val = sl::json::value(std::move(vec));
+    auto sink = sl::io::string_sink();
+    val.dump(sink);
+    slassert(val.dumps() == sink.get_string());
+    auto loaded = sl::json::loads(sink.get_string());
+    slassert(1000 == loaded.as_array().size());
+    slassert(std::string(999, 'a') == loaded.as_array()[999].as_string());
+}
+
+void test_dump_options() {
+    auto val = sl::json::loads("{\"b\": [1, 2.5, {}], \"a\": {\"d\": null, \"c\": \"\xd0\x96\xf0\x9f\x98\x80\"}}");
+    auto compact = sl::json::dump_options::compact_output();
+    slassert("{\"b\":[1,2.5,{}],\"a\":{\"d\":null,\"c\":\"\xd0\x96\xf0\x9f\x98\x80\"}}" == val.dumps(compact));
+    auto single_line = sl::json::dump_options();
+    single_line.indent = 0;
+    slassert("{\"b\": [1, 2.5, {}], \"a\": {\"d\": null, \"c\": \"\xd0\x96\xf0\x9f\x98\x80\"}}" == val.dumps(single_line));
+    auto indented = sl::json::dump_options();
+    indented.indent = 2;
+    slassert("[\n  1,\n  [\n    2\n  ]\n]" == sl::json::loads("[1, [2]]").dumps(indented));
+    auto wide = sl::json::dump_options();
+    wide.indent = 40;
+    slassert("[\n" + std::string(40, ' ') + "1\n]" == sl::json::loads("[1]").dumps(wide));
+    // default output is unchanged
+    slassert(val.dumps() == val.dumps(sl::json::dump_options()));
+    slassert(val.dumps() == sl::json::dumps(val));
+    auto sorted = sl::json::dump_options::compact_output();
+    sorted.sort_keys = true;
+    slassert("{\"a\":{\"c\":\"\xd0\x96\xf0\x9f\x98\x80\",\"d\":null},\"b\":[1,2.5,{}]}" == sl::json::dumps(val, sorted));
+    // order of fields in value is not changed
+    slassert("b" == val.as_object()[0].name());
+    auto ascii = sl::json::dump_options::compact_output();
+    ascii.ensure_ascii = true;
+    slassert("\"a\\u0416b\\uD83D\\uDE00\\n\\u00E9\"" == sl::json::dumps("a\xd0\x96" "b\xf0\x9f\x98\x80\n\xc3\xa9", ascii));
+    slassert("\"\\u0416\"" == sl::json::dumps("\xd0\x96", ascii));
+    slassert(std::string("\xd0\x96\xf0\x9f\x98\x80") == sl::json::loads(sl::json::dumps("\xd0\x96\xf0\x9f\x98\x80", ascii)).as_string());
+    auto precise = sl::json::dump_options::compact_output();
+    precise.real_precision = 3;
+    slassert("[3.14,1e-5,1.23e5,100.0,0.0,-2.5,42]" == sl::json::loads("[3.14159, 1e-5, 123456.0, 100.0, 0.0, -2.5, 42]").dumps(precise));
+    precise.real_precision = 17;
+    slassert("0.10000000000000001" == sl::json::dumps(0.1, precise));
+    precise.real_precision = 100;
+    slassert("0.10000000000000001" == sl::json::dumps(0.1, precise));
+    precise.real_precision = 1;
+    slassert("[0.3,1e1]" == sl::json::dumps(sl::json::value::packed_double_array({0.26, 9.99}), precise));
+    // packed arrays follow the same layout
+    slassert("[1,2,3]" == sl::json::value::packed_int64_array({1, 2, 3}).dumps(compact));
+    slassert("[1, 2, 3]" == sl::json::value::packed_int64_array({1, 2, 3}).dumps(single_line));
+}
+
+void test_dump_to() {
+    auto val = sl::json::loads("{\"foo\": [1, 2.5, \"bar\\n\"], \"baz\": null}");
+    auto expected = val.dumps();
+    auto buf = std::vector<char>(expected.length(), '\0');
+    slassert(expected.length() == val.dump_to({buf.data(), buf.size()}));
+    slassert(expected == std::string(buf.data(), buf.size()));
+    // overflow reports required size
+    auto small = std::vector<char>(10, 'x');
+    slassert(expected.length() == val.dump_to({small.data(), small.size()}));
+    slassert(expected.length() == val.dump_to({small.data(), static_cast<size_t> (0)}));
+    auto compact = sl::json::dump_options::compact_output();
+    auto expected_compact = val.dumps(compact);
+    auto larger = std::vector<char>(expected_compact.length() + 5, 'x');
+    slassert(expected_compact.length() == val.dump_to({larger.data(), larger.size()}, compact));
+    slassert(expected_compact == std::string(larger.data(), expected_compact.length()));
+    slassert('x' == larger[expected_compact.length()]);
+    // buffer reuse
+    slassert(2 == sl::json::value(42).dump_to({larger.data(), larger.size()}));
+    slassert("42" == std::string(larger.data(), 2));
+    bool thrown = false;
+    try {
+        sl::json::value("\xd0").dump_to({larger.data(), larger.size()});
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_serialized_size() {
+    auto val = sl::json::loads("{\"foo\": [1, -2.5e-7, \"bar\\n\\u0001\xd0\x96\"], \"baz\": null,"
+            " \"nested\": {\"b\": [[], {}], \"a\": true}}");
+    slassert(val.dumps().length() == val.serialized_size());
+    auto opts = sl::json::dump_options::compact_output();
+    slassert(val.dumps(opts).length() == val.serialized_size(opts));
+    opts.compact = false;
+    opts.indent = 0;
+    opts.sort_keys = true;
+    opts.ensure_ascii = true;
+    opts.real_precision = 3;
+    slassert(val.dumps(opts).length() == val.serialized_size(opts));
+    slassert(4 == sl::json::value().serialized_size());
+    auto packed = sl::json::value::packed_double_array({0.5, 1e100});
+    slassert(packed.dumps().length() == packed.serialized_size());
+    // integer lengths are counted without formatting
+    int64_t num = 1;
+    for (int i = 0; i < 19; i++) {
+        for (int64_t delta = -1; delta <= 1; delta++) {
+            auto ints = sl::json::value::packed_int64_array({num + delta, -num - delta});
+            slassert(ints.dumps().length() == ints.serialized_size());
+        }
+        if (i < 18) {
+            num *= 10;
+        }
+    }
+    auto limits = sl::json::value::packed_int64_array({std::numeric_limits<int64_t>::max(),
+            std::numeric_limits<int64_t>::min(), 0});
+    slassert(limits.dumps().length() == limits.serialized_size());
+    auto non_ascii = sl::json::value("\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+    slassert(non_ascii.dumps(opts).length() == non_ascii.serialized_size(opts));
+    bool thrown = false;
+    try {
+        sl::json::value(std::numeric_limits<double>::quiet_NaN()).serialized_size();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+class counting_handler {
+public:
+    std::vector<std::string> events;
+
+    void start_object() {
+        events.push_back("{");
+    }
+
+    void key(const std::string& name) {
+        events.push_back("k:" + name);
+    }
+
+    void end_object() {
+        events.push_back("}");
+    }
+
+    void start_array() {
+        events.push_back("[");
+    }
+
+    void end_array() {
+        events.push_back("]");
+    }
+
+    void string(const std::string& val) {
+        events.push_back("s:" + val);
+    }
+
+    void integer(int64_t val) {
+        events.push_back("i:" + sl::support::to_string(val));
+    }
+
+    void real(double val) {
+        events.push_back("r:" + sl::support::to_string(val));
+    }
+
+    void boolean(bool val) {
+        events.push_back(val ? "true" : "false");
+    }
+
+    void null() {
+        events.push_back("null");
+    }
+};
+
+void test_load_events() {
+    auto handler = counting_handler();
+    sl::json::loads(test_json_str, handler);
+    auto expected = std::vector<std::string>{
+        "{", "k:f1", "i:41", "k:f2", "s:42", "k:f3", "true",
+        "k:f4", "[", "i:41", "s:43", "]",
+        "k:f5", "{", "k:f42", "i:42", "k:fnullable", "null", "}", "}"
+    };
+    slassert(expected == handler.events);
+
+    auto handler_src = counting_handler();
+    auto src = sl::io::array_source(test_json_str.data(), test_json_str.size());
+    sl::json::load(src, handler_src);
+    slassert(expected == handler_src.events);
+
+    auto handler_sbuf = counting_handler();
+    auto sbuf = sl::io::make_unbuffered_istreambuf(sl::io::array_source(test_json_str.data(), test_json_str.size()));
+    sl::json::load(std::addressof(sbuf), handler_sbuf);
+    slassert(expected == handler_sbuf.events);
+
+    auto handler_real = counting_handler();
+    sl::json::loads("[1.5, false]", handler_real);
+    slassert(4 == handler_real.events.size());
+    slassert("r:1.5" == handler_real.events[1]);
+    slassert("false" == handler_real.events[2]);
+
+    bool thrown = false;
+    try {
+        auto handler_err = counting_handler();
+        sl::json::loads("[1, 2", handler_err);
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_load_borrowed() {
+    auto str = std::string("{\"id\": \"foo\", \"utf8\": \"\xd0\x96\", \"esc\": \"a\\nb\", \"list\": [\"bar\"]}");
+    auto val = sl::json::load_borrowed({str.data(), str.length()});
+    slassert(val["id"].is_string_borrowed());
+    slassert(val["utf8"].is_string_borrowed());
+    slassert(!val["esc"].is_string_borrowed());
+    slassert(val["list"].as_array()[0].is_string_borrowed());
+    slassert(str.data() + 8 == val["id"].as_string_span().data());
+    slassert(sl::json::loads(str).dumps() == val.dumps());
+    slassert("a\nb" == val["esc"].as_string());
+    slassert("foo" == val["id"].as_string());
+    // errors are reported same way
+    bool thrown = false;
+    try {
+        auto bad = std::string("[\"\xc0\xaf\"]");
+        sl::json::load_borrowed({bad.data(), bad.length()});
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_load_in_situ() {
+    auto json = std::string("{\"id\": \"foo\", \"esc\": \"a\\nb\\u0416\\ud83d\\ude00c\", \"utf8\": \"\xd0\x96\\t\",\"list\": [\"\\\"bar\\\"\"]}");
+    auto buf = std::vector<char>(json.begin(), json.end());
+    auto val = sl::json::load(sl::io::span<char>(buf.data(), buf.size()));
+    slassert(val["id"].is_string_borrowed());
+    slassert(val["esc"].is_string_borrowed());
+    slassert(val["utf8"].is_string_borrowed());
+    slassert(val["list"].as_array()[0].is_string_borrowed());
+    slassert(buf.data() + 22 == val["esc"].as_string_span().data());
+    slassert(std::string("a\nb\xd0\x96\xf0\x9f\x98\x80" "c") == val["esc"].as_string());
+    slassert("\xd0\x96\t" == val["utf8"].as_string());
+    slassert("\"bar\"" == val["list"].as_array()[0].as_string());
+    slassert(sl::json::loads(json).dumps() == val.dumps());
+    // errors are reported same way
+    bool thrown = false;
+    try {
+        auto bad = std::string("[\"a\\nb\xc0\xaf\"]");
+        sl::json::load(sl::io::span<char>(&bad.front(), bad.length()));
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_load_packed() {
+    auto json = std::string("{\"ints\": [1, -2, 3], \"reals\": [0.5, 1e3], \"mixed\": [1, 2.5],"
+            " \"nested\": [[1, 2], [3.5]], \"empty\": [], \"strings\": [\"foo\"]}");
+    auto val = sl::json::load_packed({json.data(), json.length()});
+    slassert(val["ints"].is_array_packed());
+    slassert(3 == val["ints"].as_int64_span().size());
+    slassert(-2 == val["ints"].as_int64_span()[1]);
+    slassert(val["reals"].is_array_packed());
+    slassert(1000.0 == val["reals"].as_double_span()[1]);
+    slassert(!val["mixed"].is_array_packed());
+    slassert(!val["nested"].is_array_packed());
+    slassert(val["nested"].as_array()[0].is_array_packed());
+    slassert(val["nested"].as_array()[1].is_array_packed());
+    slassert(!val["empty"].is_array_packed());
+    slassert(!val["strings"].is_array_packed());
+    slassert(sl::json::loads(json).dumps() == val.dumps());
+}
+
 int main() {
     try {
         test_dumps();
@@ -169,6 +556,17 @@ int main() {
         test_preserve_order();
         test_dump_string();
         test_dumps_short();
+        test_dump_scalars();
+        test_dump_escapes();
+        test_dump_scan();
+        test_dump_streambuf();
+        test_dump_options();
+        test_dump_to();
+        test_serialized_size();
+        test_load_events();
+        test_load_borrowed();
+        test_load_in_situ();
+        test_load_packed();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   parser_test.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 1:05 PM
+ */
+
+#include "staticlib/json/parser.hpp"
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/operations.hpp"
+
+// returns input one byte at a time to check buffer boundaries
+class byte_source {
+    std::string data;
+    size_t idx = 0;
+    bool empty_read = false;
+
+public:
+    byte_source(std::string data) :
+    data(std::move(data)) { }
+
+    std::streamsize read(sl::io::span<char> span) {
+        if (idx >= data.length()) {
+            return std::char_traits<char>::eof();
+        }
+        // emulate non-blocking source
+        empty_read = !empty_read;
+        if (empty_read) {
+            return 0;
+        }
+        span.data()[0] = data[idx++];
+        return 1;
+    }
+};
+
+bool throws_exc(std::function<void()> fun) {
+    try {
+        fun();
+    } catch (const sl::json::json_exception& e) {
+        (void) e;
+        return true;
+    }
+    return false;
+}
+
+sl::json::value parse_bytes(const std::string& str) {
+    auto src = byte_source(str);
+    auto pr = sl::json::make_parser(src);
+    return pr.parse();
+}
+
+void test_scalars() {
+    slassert(sl::json::type::nullt == sl::json::loads("null").json_type());
+    slassert(sl::json::loads("true").as_bool());
+    slassert(!sl::json::loads(" false ").as_bool_or_throw());
+    slassert(42 == sl::json::loads("42").as_int64_or_throw());
+    slassert(-42 == sl::json::loads("-42").as_int64_or_throw());
+    slassert(0 == sl::json::loads("-0").as_int64_or_throw());
+    slassert(std::numeric_limits<int64_t>::max() == sl::json::loads("9223372036854775807").as_int64_or_throw());
+    slassert(std::numeric_limits<int64_t>::min() == sl::json::loads("-9223372036854775808").as_int64_or_throw());
+    slassert(1.5 == sl::json::loads("1.5").as_double_or_throw());
+    slassert(-150.0 == sl::json::loads("-1.5e2").as_double_or_throw());
+    slassert(0.015 == sl::json::loads("1.5E-2").as_double_or_throw());
+    slassert(1.0 == sl::json::loads("1.0").as_double_or_throw());
+    slassert("foo" == sl::json::loads("\"foo\"").as_string_or_throw());
+}
+
+void test_numbers() {
+    const char* reals[] = {
+        "0.1", "-0.0", "1e23", "2.2250738585072011e-308", "4.9406564584124654e-324",
+        "2.4703282292062328e-324", "1e-400", "9007199254740993.0", "1.7976931348623157e308",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "123456789012345678901234567890.5", "0.000000000000000000000000000000000000000000000001e48",
+        "7.2057594037927933e16", "-12.345e-67"
+    };
+    for (const char* num : reals) {
+        double expected = std::strtod(num, nullptr);
+        slassert(expected == sl::json::loads(num).as_double_or_throw());
+        slassert(expected == parse_bytes(num).as_double_or_throw());
+        slassert(expected == parse_bytes(std::string("[") + num + "]").as_array()[0].as_double());
+    }
+    slassert(std::signbit(sl::json::loads("-0.0").as_double()));
+    slassert(-1234567890123456789 == parse_bytes("-1234567890123456789").as_int64_or_throw());
+    slassert(throws_exc([] { sl::json::loads("1.7976931348623159e308"); }));
+    slassert(throws_exc([] { parse_bytes("-1e99999999999999999999"); }));
+    slassert(throws_exc([] { sl::json::loads("99999999999999999999"); }));
+    // conversion does not depend on locale
+    if (nullptr != std::setlocale(LC_NUMERIC, "de_DE.UTF-8") || nullptr != std::setlocale(LC_NUMERIC, "ru_RU.UTF-8")) {
+        slassert(1.5 == sl::json::loads("1.5").as_double_or_throw());
+        slassert(std::strtod("123456789012345678901234567890,5", nullptr) ==
+                sl::json::loads("123456789012345678901234567890.5").as_double_or_throw());
+        std::setlocale(LC_NUMERIC, "C");
+    }
+}
+
+void test_strings() {
+    auto val = sl::json::loads(R"("a\"b\\c\/d\b\f\n\r\t")");
+    slassert("a\"b\\c/d\b\f\n\r\t" == val.as_string_or_throw());
+    slassert("\xd0\x96" == sl::json::loads("\"\\u0416\"").as_string_or_throw());
+    slassert("\xd0\x96" == sl::json::loads("\"\xd0\x96\"").as_string_or_throw());
+    slassert("\xf0\x9f\x98\x80" == sl::json::loads("\"\\ud83d\\ude00\"").as_string_or_throw());
+    slassert("\xf0\x9f\x98\x80" == parse_bytes("\"\xf0\x9f\x98\x80\"").as_string_or_throw());
+    auto long_str = std::string(10000, 'a');
+    slassert(long_str == parse_bytes("\"" + long_str + "\"").as_string_or_throw());
+}
+
+void test_containers() {
+    auto val = parse_bytes(" { \"foo\" : [ 1 , 2.5 , \"bar\" , { } , [ ] ] , \"baz\" : { \"a\" : null } } ");
+    auto& obj = val.as_object_or_throw();
+    slassert(2 == obj.size());
+    slassert("foo" == obj[0].name());
+    auto& arr = obj[0].as_array_or_throw();
+    slassert(5 == arr.size());
+    slassert(1 == arr[0].as_int64_or_throw());
+    slassert(2.5 == arr[1].as_double_or_throw());
+    slassert("bar" == arr[2].as_string_or_throw());
+    slassert(sl::json::type::object == arr[3].json_type());
+    slassert(0 == arr[3].as_object().size());
+    slassert(sl::json::type::array == arr[4].json_type());
+    slassert(0 == arr[4].as_array().size());
+    slassert("baz" == obj[1].name());
+    slassert(sl::json::type::nullt == obj[1].val()["a"].json_type());
+}
+
+void test_large_object() {
+    std::string json = "{";
+    for (int i = 0; i < 100; i++) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "\"f" + sl::support::to_string(i) + "\": " + sl::support::to_string(i);
+    }
+    json += "}";
+    auto val = sl::json::loads(json);
+    slassert(100 == val.as_object().size());
+    slassert(99 == val["f99"].as_int64());
+    // duplicate detected with hash set
+    json.back() = ',';
+    json += "\"f42\": 42}";
+    slassert(throws_exc([&json] { sl::json::loads(json); }));
+}
+
+void test_partial() {
+    slassert(42 == sl::json::loads("42 foo").as_int64());
+    slassert(3 == sl::json::loads("[1,2,3]i am a foobar").as_array().size());
+    slassert(3 == parse_bytes("[1,2,3]i am a foobar").as_array().size());
+}
+
+void test_errors() {
+    slassert(throws_exc([] { sl::json::loads(""); }));
+    slassert(throws_exc([] { sl::json::loads("   "); }));
+    slassert(throws_exc([] { sl::json::loads("nul"); }));
+    slassert(throws_exc([] { sl::json::loads("nullx"); }));
+    slassert(throws_exc([] { sl::json::loads("01"); }));
+    slassert(throws_exc([] { sl::json::loads("1."); }));
+    slassert(throws_exc([] { sl::json::loads("1e"); }));
+    slassert(throws_exc([] { sl::json::loads("-"); }));
+    slassert(throws_exc([] { sl::json::loads("9223372036854775808"); }));
+    slassert(throws_exc([] { sl::json::loads("-9223372036854775809"); }));
+    slassert(throws_exc([] { sl::json::loads("1e999"); }));
+    slassert(throws_exc([] { sl::json::loads("\"foo"); }));
+    slassert(throws_exc([] { sl::json::loads("\"\\x\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\\u0000\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\\ud83d\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\\ude00\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\x01\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\xc0\xaf\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\xed\xa0\x80\""); }));
+    slassert(throws_exc([] { sl::json::loads("\"\xd0\""); }));
+    slassert(throws_exc([] { sl::json::loads("[1,]"); }));
+    slassert(throws_exc([] { sl::json::loads("[1 2]"); }));
+    slassert(throws_exc([] { sl::json::loads("{\"a\" 1}"); }));
+    slassert(throws_exc([] { sl::json::loads("{\"a\": 1,}"); }));
+    slassert(throws_exc([] { sl::json::loads("{a: 1}"); }));
+    slassert(throws_exc([] { sl::json::loads("{\"a\": 1, \"a\": 2}"); }));
+    slassert(throws_exc([] { sl::json::loads(std::string(4096, '[')); }));
+}
+
+void test_error_position() {
+    std::string msg;
+    try {
+        sl::json::loads("{\n    \"foo\": 42,\n    \"bar\": x\n}");
+    } catch (const sl::json::json_exception& e) {
+        msg = e.what();
+    }
+    slassert(std::string::npos != msg.find("line: [3]"));
+    slassert(std::string::npos != msg.find("column: [13]"));
+}
+
+void test_scan() {
+    // special byte at every position of every block
+    for (size_t len = 0; len < 80; len++) {
+        for (size_t idx = 0; idx <= len; idx++) {
+            std::string str(len, 'a');
+            std::string ws(len, ' ');
+            if (idx < len) {
+                str[idx] = '\x80';
+                ws[idx] = 'x';
+            }
+            const char* begin = str.data();
+            slassert(begin + idx == sl::json::detail_parser::find_string_special(begin, begin + len));
+            str[idx < len ? idx : 0] = idx % 2 ? '"' : '\x1f';
+            if (idx < len) {
+                slassert(begin + idx == sl::json::detail_parser::find_string_special(begin, begin + len));
+            }
+            str[idx < len ? idx : 0] = '}';
+            if (idx < len) {
+                slassert(begin + idx == sl::json::detail_parser::find_structural(begin, begin + len));
+            }
+            for (size_t i = 0; i < idx; i += 3) {
+                ws[i] = '\n';
+            }
+            size_t lines = 0;
+            const char* last = nullptr;
+            const char* wsbegin = ws.data();
+            slassert(wsbegin + idx == sl::json::detail_parser::skip_whitespace(wsbegin, wsbegin + len, lines, last));
+            slassert((idx + 2) / 3 == lines);
+            slassert(0 == idx || wsbegin + ((idx - 1) / 3) * 3 == last);
+        }
+    }
+}
+
+int main() {
+    try {
+        test_scan();
+        test_scalars();
+        test_numbers();
+        test_strings();
+        test_containers();
+        test_large_object();
+        test_partial();
+        test_errors();
+        test_error_position();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
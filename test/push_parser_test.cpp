@@ -0,0 +1,153 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   push_parser_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:15 PM
+ */
+
+#include "staticlib/json/push_parser.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/json/operations.hpp"
+
+const std::string test_json = R"({
+    "foo": [1, 2.5, "bar", {}, [], true, false, null],
+    "esc": "a\"b\\c\n\u0416\ud83d\ude00",
+    "neg": -42,)" "\n"
+"    \"utf8\": \"\xd0\x96\xf0\x9f\x98\x80\"\n"
+"}";
+
+bool throws_exc(std::function<void()> fun) {
+    try {
+        fun();
+    } catch (const sl::json::json_exception& e) {
+        (void) e;
+        return true;
+    }
+    return false;
+}
+
+void feed_bytes(sl::json::push_parser& pp, const std::string& str) {
+    for (size_t i = 0; i < str.length(); i++) {
+        pp.feed({str.data() + i, 1});
+    }
+}
+
+void test_chunked() {
+    auto expected = sl::json::loads(test_json).dumps();
+    sl::json::push_parser pp;
+    feed_bytes(pp, test_json);
+    slassert(pp.has_value());
+    slassert(!pp.in_progress());
+    slassert(expected == pp.pop_value().dumps());
+    slassert(!pp.has_value());
+    slassert(test_json.length() == pp.position());
+}
+
+void test_partial() {
+    sl::json::push_parser pp;
+    auto head = std::string("{\"foo\": [1, \"ba");
+    slassert(0 == pp.feed({head.data(), head.length()}));
+    slassert(pp.in_progress());
+    auto tail = std::string("r\"]} [4");
+    slassert(1 == pp.feed({tail.data(), tail.length()}));
+    slassert("bar" == pp.pop_value()["foo"].as_array()[1].as_string());
+    slassert(pp.in_progress());
+    auto rest = std::string("2]");
+    slassert(1 == pp.feed({rest.data(), rest.length()}));
+    slassert(42 == pp.pop_value().as_array()[0].as_int64());
+    slassert(!pp.in_progress());
+}
+
+void test_multiple() {
+    sl::json::push_parser pp;
+    auto str = std::string("{\"a\": 1}\n{\"a\": 2}\n\"foo\" 42 true");
+    slassert(4 == pp.feed({str.data(), str.length()}));
+    // trailing literal is completed on finish
+    slassert(5 == pp.finish());
+    slassert(1 == pp.pop_value()["a"].as_int64());
+    slassert(2 == pp.pop_value()["a"].as_int64());
+    slassert("foo" == pp.pop_value().as_string());
+    slassert(42 == pp.pop_value().as_int64());
+    slassert(pp.pop_value().as_bool());
+    slassert(throws_exc([&pp] { pp.pop_value(); }));
+}
+
+void test_errors() {
+    auto fails = [](const std::string& str) {
+        return throws_exc([&str] {
+            sl::json::push_parser pp;
+            feed_bytes(pp, str);
+            pp.finish();
+        });
+    };
+    slassert(fails("[1,]"));
+    slassert(fails("[1 2]"));
+    slassert(fails("{\"a\" 1}"));
+    slassert(fails("{\"a\": 1,}"));
+    slassert(fails("{\"a\": 1, \"a\": 2}"));
+    slassert(fails("[1}"));
+    slassert(fails("01"));
+    slassert(fails("1."));
+    slassert(fails("nullx"));
+    slassert(fails("9223372036854775808"));
+    slassert(fails("\"\\u0000\""));
+    slassert(fails("\"\\ud83d\""));
+    slassert(fails("\"\xc0\xaf\""));
+    slassert(fails("{\"a\": [1, 2"));
+    slassert(fails("\"foo"));
+    slassert(fails(std::string(4096, '[')));
+    // failed state
+    sl::json::push_parser pp;
+    auto str = std::string("]");
+    slassert(throws_exc([&pp, &str] { pp.feed({str.data(), str.length()}); }));
+    auto valid = std::string("42 ");
+    slassert(throws_exc([&pp, &valid] { pp.feed({valid.data(), valid.length()}); }));
+}
+
+void test_error_position() {
+    std::string msg;
+    try {
+        sl::json::push_parser pp;
+        feed_bytes(pp, "{\n    \"foo\": 42,\n    \"bar\": x\n}");
+    } catch (const sl::json::json_exception& e) {
+        msg = e.what();
+    }
+    slassert(std::string::npos != msg.find("line: [3]"));
+    slassert(std::string::npos != msg.find("column: [13]"));
+}
+
+int main() {
+    try {
+        test_chunked();
+        test_partial();
+        test_multiple();
+        test_errors();
+        test_error_position();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 5:02 PM
+ */
+
+#include "staticlib/json/reader.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/json/field.hpp"
+
+const std::string test_json = R"({
+    "id": 42,
+    "skipped": {"foo": [1, 2, {"bar": "baz"}], "empty": []},
+    "name": "foo",
+    "ratio": 0.5,
+    "enabled": true,
+    "nothing": null,
+    "list": [1, "two", 3.0],
+    "tail": "ignored"
+} trailing data)";
+
+void test_tokens() {
+    auto src = sl::io::array_source(test_json.data(), test_json.size());
+    auto rd = sl::json::make_reader(src);
+    slassert(sl::json::token::start_object == rd.next());
+    slassert(1 == rd.depth());
+    slassert("id" == rd.read_string());
+    slassert(42 == rd.read_int64());
+    rd.skip_value();
+    slassert(sl::json::token::key == rd.next());
+    slassert("name" == rd.get_string());
+    slassert("foo" == rd.read_string());
+    slassert("ratio" == rd.read_string());
+    slassert(0.5 == rd.read_double());
+    slassert("enabled" == rd.read_string());
+    slassert(rd.read_bool());
+    slassert("nothing" == rd.read_string());
+    slassert(sl::json::token::nullt == rd.next());
+    slassert("list" == rd.read_string());
+    slassert(sl::json::token::start_array == rd.next());
+    slassert(1 == rd.read_int64());
+    slassert("two" == rd.read_string());
+    slassert(3.0 == rd.read_double());
+    slassert(sl::json::token::end_array == rd.next());
+    rd.skip_value();
+    slassert(sl::json::token::end_object == rd.next());
+    slassert(0 == rd.depth());
+    slassert(sl::json::token::end_of_input == rd.next());
+    slassert(sl::json::token::end_of_input == rd.next());
+}
+
+void test_read_value() {
+    auto rd = sl::json::make_reader(sl::io::span<const char>(test_json.data(), test_json.size()));
+    slassert(sl::json::token::start_object == rd.next());
+    slassert("id" == rd.read_string());
+    slassert(42 == rd.read_int64());
+    slassert("skipped" == rd.read_string());
+    auto val = rd.read_value();
+    slassert("baz" == val["foo"].as_array()[2]["bar"].as_string());
+    slassert("name" == rd.read_string());
+}
+
+void test_read_value_siblings() {
+    auto rd = sl::json::make_reader(sl::io::span<const char>(R"([1, {"a": 1}, {"b": 2}, [3]])"));
+    slassert(sl::json::token::start_array == rd.next());
+    slassert(1 == rd.read_int64());
+    auto first = rd.read_value();
+    slassert(1 == first["a"].as_int64());
+    auto second = rd.read_value();
+    slassert(2 == second["b"].as_int64());
+    auto third = rd.read_value();
+    slassert(3 == third.as_array()[0].as_int64());
+    bool thrown = false;
+    try {
+        rd.read_value();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // closing bracket is not consumed
+    slassert(1 == rd.depth());
+    slassert(sl::json::token::end_array == rd.next());
+    slassert(0 == rd.depth());
+    slassert(sl::json::token::end_of_input == rd.next());
+    // same for empty container
+    auto rd_empty = sl::json::make_reader(sl::io::span<const char>("[]"));
+    slassert(sl::json::token::start_array == rd_empty.next());
+    thrown = false;
+    try {
+        rd_empty.read_value();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(sl::json::token::end_array == rd_empty.next());
+}
+
+void test_read_value_depth() {
+    // nesting limit applies to the enclosing containers too
+    std::string ok = "[" + std::string(sl::json::detail_parser::max_depth - 1, '[') +
+            std::string(sl::json::detail_parser::max_depth, ']');
+    auto rd_ok = sl::json::make_reader(sl::io::span<const char>(ok.data(), ok.size()));
+    slassert(sl::json::token::start_array == rd_ok.next());
+    rd_ok.read_value();
+    slassert(sl::json::token::end_array == rd_ok.next());
+    std::string deep = "[" + std::string(sl::json::detail_parser::max_depth, '[') +
+            std::string(sl::json::detail_parser::max_depth + 1, ']');
+    auto rd = sl::json::make_reader(sl::io::span<const char>(deep.data(), deep.size()));
+    slassert(sl::json::token::start_array == rd.next());
+    bool thrown = false;
+    try {
+        rd.read_value();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_stop_early() {
+    auto src = sl::io::array_source(test_json.data(), test_json.size());
+    auto rd = sl::json::make_reader(src);
+    slassert(sl::json::token::start_object == rd.next());
+    slassert("id" == rd.read_string());
+    slassert(42 == rd.read_int64());
+}
+
+void test_errors() {
+    bool thrown = false;
+    try {
+        auto rd = sl::json::make_reader(sl::io::span<const char>("[1, 2}"));
+        while (sl::json::token::end_of_input != rd.next());
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        auto rd = sl::json::make_reader(sl::io::span<const char>("{\"foo\": 42}"));
+        rd.next();
+        rd.read_int64();
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        auto rd = sl::json::make_reader(sl::io::span<const char>("[1, ]"));
+        while (sl::json::token::end_of_input != rd.next());
+    } catch (const sl::json::json_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_tokens();
+        test_read_value();
+        test_read_value_siblings();
+        test_read_value_depth();
+        test_stop_early();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
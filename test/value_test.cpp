@@ -23,9 +23,13 @@
 
 #include "staticlib/json/value.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "staticlib/config/assert.hpp"
 
@@ -190,6 +194,77 @@ void test_string() {
     slassert("43" == rvc.as_string());       
 }
 
+void test_string_borrowed() {
+    std::string data = "foobar";
+    auto rv = sl::json::value::borrowed_string({data.data(), 3});
+    slassert(sl::json::type::string == rv.json_type());
+    slassert(rv.is_string_borrowed());
+    slassert(3 == rv.as_string_span().size());
+    slassert(data.data() == rv.as_string_span().data());
+    slassert("\"foo\"" == rv.dumps());
+    // clone is owned
+    auto cl = rv.clone();
+    slassert(!cl.is_string_borrowed());
+    slassert("foo" == cl.as_string());
+    // move keeps borrowed data
+    auto moved = std::move(rv);
+    slassert(moved.is_string_borrowed());
+    slassert(sl::json::type::nullt == rv.json_type());
+    // const access publishes std::string once and keeps data borrowed
+    auto span = moved.as_string_span();
+    const std::string& published = moved.as_string();
+    slassert("foo" == published);
+    const sl::json::value& moved_const = moved;
+    slassert(std::addressof(published) == std::addressof(moved_const.as_string_or_throw()));
+    slassert(moved.is_string_borrowed());
+    slassert("foo" == std::string(span.data(), span.size()));
+    slassert(3 == moved.as_string_span().size());
+    // converted on mutable access
+    std::string& owned = moved.as_string_or_throw();
+    slassert("foo" == owned);
+    slassert(!moved.is_string_borrowed());
+    data[0] = 'b';
+    slassert("foo" == moved.as_string());
+    // setter
+    auto st = sl::json::value::borrowed_string({data.data(), data.length()});
+    slassert(st.set_string("baz"));
+    slassert("baz" == st.as_string());
+    // string markers and borrowed length are packed before the string word
+    slassert(16 == sizeof(sl::json::value));
+}
+
+void test_string_inline() {
+    auto vec = std::vector<sl::json::value>();
+    for (size_t i = 0; i < 100; i++) {
+        // short and long strings
+        vec.emplace_back(std::string(i, 'a'));
+    }
+    for (size_t i = 0; i < 100; i++) {
+        slassert(std::string(i, 'a') == vec[i].as_string());
+    }
+    auto moved = std::move(vec[42]);
+    slassert(std::string(42, 'a') == moved.as_string());
+    slassert(sl::json::type::nullt == vec[42].json_type());
+    vec[3] = std::move(moved);
+    slassert(std::string(42, 'a') == vec[3].as_string());
+    vec[4] = std::move(vec[5]);
+    slassert("aaaaa" == vec[4].as_string());
+    vec[4].as_string_or_throw() += "b";
+    slassert(6 == vec[4].as_string_span().size());
+    vec[6] = sl::json::value(42);
+    slassert(42 == vec[6].as_int64());
+    // longest inline string is moved to heap on mutable access
+    auto six = sl::json::value(std::string(6, 'b'));
+    auto copy = six.clone();
+    const std::string& published = six.as_string();
+    slassert(std::addressof(published) == std::addressof(six.as_string()));
+    six.as_string_or_throw().append(100, 'c');
+    slassert(106 == six.as_string_span().size());
+    slassert(std::string(6, 'b') == copy.as_string());
+    slassert(copy.set_string(std::string(7, 'd')));
+    slassert(std::string(7, 'd') == copy.as_string());
+}
+
 void test_string_default() {
     sl::json::value rv{};
     (void) rv;
@@ -395,6 +470,167 @@ void test_get_or_throw() {
     slassert(caught);
 }
 
+void test_object_index() {
+    auto fields = std::vector<sl::json::field>();
+    for (int i = 0; i < 100; i++) {
+        fields.emplace_back("f" + sl::support::to_string(i), i);
+    }
+    // duplicate, first field is returned
+    fields.emplace_back("f42", -1);
+    auto val = sl::json::value(std::move(fields));
+    sl::json::value::set_object_index_threshold(8);
+    for (int i = 0; i < 100; i++) {
+        slassert(i == val["f" + sl::support::to_string(i)].as_int64());
+    }
+    slassert(42 == val["f42"].as_int64());
+    slassert(sl::json::type::nullt == val["foo"].json_type());
+    // append
+    for (int i = 100; i < 200; i++) {
+        val.getattr_or_throw("f" + sl::support::to_string(i)).set_int64(i);
+    }
+    slassert(201 == val.as_object().size());
+    slassert(199 == val["f199"].as_int64());
+    slassert(1 == val.getattr_or_throw("f1").as_int64());
+    // order is preserved
+    slassert("f100" == val.as_object()[101].name());
+    // change through the mutable reference
+    auto& obj = val.as_object_or_throw();
+    obj.erase(obj.begin());
+    obj[0] = sl::json::field("bar", 43);
+    slassert(sl::json::type::nullt == val["f0"].json_type());
+    slassert(sl::json::type::nullt == val["f1"].json_type());
+    slassert(43 == val["bar"].as_int64());
+    slassert(2 == val["f2"].as_int64());
+    // removal after the lookup is detected
+    obj.pop_back();
+    slassert(sl::json::type::nullt == val["f199"].json_type());
+    // rename, replacement, sort and erase with append through the held reference
+    slassert(3 == val["f3"].as_int64());
+    obj[2] = sl::json::field("renamed", 3);
+    slassert(sl::json::type::nullt == val["f3"].json_type());
+    slassert(3 == val["renamed"].as_int64());
+    obj[3] = sl::json::field("f3", 33);
+    slassert(33 == val["f3"].as_int64());
+    std::sort(obj.begin(), obj.end(), [](const sl::json::field& a, const sl::json::field& b) {
+        return a.name() < b.name();
+    });
+    slassert(33 == val["f3"].as_int64());
+    slassert(150 == val["f150"].as_int64());
+    obj.erase(obj.begin() + 10);
+    obj.emplace_back("appended", 45);
+    slassert(45 == val["appended"].as_int64());
+    slassert(45 == val.getattr_or_throw("appended").as_int64());
+    slassert(3 == val.getattr_or_throw("renamed").as_int64());
+    auto replaced = std::vector<sl::json::field>();
+    replaced.emplace_back("baz", 44);
+    val.set_object(std::move(replaced));
+    slassert(44 == val["baz"].as_int64());
+    slassert(sl::json::type::nullt == val["bar"].json_type());
+    // clone
+    auto cl = val.clone();
+    slassert(44 == cl["baz"].as_int64());
+    sl::json::value::set_object_index_threshold(32);
+}
+
+void test_clone_shared() {
+    auto tmpl = sl::json::value({
+        {"meta", {
+            {"id", 42},
+            {"tags", std::vector<sl::json::value>{}}
+        }},
+        {"list", [] {
+            auto vec = std::vector<sl::json::value>();
+            vec.emplace_back("foo");
+            vec.emplace_back(sl::json::value({{"bar", true}}));
+            return vec;
+        }()}
+    });
+    auto copy = tmpl.clone_shared();
+    slassert(copy.dumps() == tmpl.dumps());
+    // nodes are shared
+    slassert(&tmpl.as_object() == &copy.as_object());
+    slassert(&tmpl["list"].as_array() == &copy["list"].as_array());
+    // copied on mutable access
+    copy.getattr_or_throw("meta").getattr_or_throw("id").set_int64(43);
+    slassert(&tmpl.as_object() != &copy.as_object());
+    slassert(&tmpl["meta"].as_object() != &copy["meta"].as_object());
+    slassert(&tmpl["list"].as_array() == &copy["list"].as_array());
+    slassert(42 == tmpl["meta"]["id"].as_int64());
+    slassert(43 == copy["meta"]["id"].as_int64());
+    copy.getattr_or_throw("list").as_array_or_throw()[1].getattr_or_throw("bar").set_bool(false);
+    slassert(tmpl["list"].as_array()[1]["bar"].as_bool());
+    slassert(!copy["list"].as_array()[1]["bar"].as_bool());
+    slassert(&tmpl["list"].as_array()[0] != &copy["list"].as_array()[0]);
+    // original is copied too when it is changed
+    auto second = tmpl.clone_shared();
+    tmpl.as_object_or_throw().emplace_back("baz", 1);
+    slassert(3 == tmpl.as_object().size());
+    slassert(2 == second.as_object().size());
+    slassert(second["list"].as_array()[1]["bar"].as_bool());
+    // set_* does not change shared nodes
+    auto third = second.clone_shared();
+    third.set_object(std::vector<sl::json::field>());
+    slassert(0 == third.as_object().size());
+    slassert(2 == second.as_object().size());
+    auto arr = second["list"].clone_shared();
+    arr.set_array(std::vector<sl::json::value>());
+    slassert(2 == second["list"].as_array().size());
+    // scalars and strings are copied
+    slassert("foo" == second["list"].as_array()[0].clone_shared().as_string());
+    // references handed out before the clone
+    auto& items = arr.as_array_or_throw();
+    auto arr_copy = arr.clone_shared();
+    items.push_back(42);
+    slassert(1 == items.size());
+    slassert(0 == arr_copy.as_array().size());
+    auto& fields = third.as_object_or_throw();
+    sl::json::value& attr = third.getattr_or_throw("attr");
+    auto third_copy = third.clone_shared();
+    attr.set_int64(43);
+    fields.emplace_back("baz", 1);
+    slassert(1 == third_copy.as_object().size());
+    slassert(sl::json::type::nullt == third_copy["attr"].json_type());
+}
+
+void test_packed_array() {
+    auto val = sl::json::value::packed_double_array({1.5, -2.0, 3.25});
+    slassert(sl::json::type::array == val.json_type());
+    slassert(val.is_array_packed());
+    slassert(3 == val.as_double_span().size());
+    slassert(-2.0 == val.as_double_span()[1]);
+    slassert(0 == val.as_int64_span().size());
+    slassert(sl::json::type::real == val.packed_array_type());
+    slassert("[\n    1.5,\n    -2.0,\n    3.25\n]" == val.dumps());
+    // expanded on generic access
+    const auto& expanded = val.as_array();
+    slassert(3 == expanded.size());
+    slassert(3.25 == expanded[2].as_double());
+    slassert(&expanded == &val.as_array());
+    slassert(val.is_array_packed());
+    // copies stay packed
+    auto ints = sl::json::value::packed_int64_array({1, 2, 3});
+    auto copy = ints.clone();
+    slassert(copy.is_array_packed());
+    slassert(copy.as_int64_span().data() != ints.as_int64_span().data());
+    auto shared = ints.clone_shared();
+    slassert(shared.as_int64_span().data() == ints.as_int64_span().data());
+    shared.as_array_or_throw().emplace_back("foo");
+    slassert(!shared.is_array_packed());
+    slassert(ints.is_array_packed());
+    slassert(3 == ints.as_int64_span().size());
+    slassert(4 == shared.as_array().size());
+    // unpacked on mutable access
+    ints.as_array_or_throw()[0].set_int64(42);
+    slassert(!ints.is_array_packed());
+    slassert(0 == ints.as_int64_span().size());
+    slassert(42 == ints.as_array()[0].as_int64());
+    slassert(sl::json::type::nullt == ints.packed_array_type());
+    auto empty = sl::json::value::packed_int64_array(std::vector<int64_t>());
+    slassert(sl::json::type::integer == empty.packed_array_type());
+    slassert("[]" == empty.dumps());
+    slassert(!sl::json::value(std::vector<sl::json::value>()).is_array_packed());
+}
+
 void test_tmp() {
     auto val = sl::json::value("42");
     std::cout << sl::json::stringify_json_type(val.json_type()) << std::endl;
@@ -406,6 +642,8 @@ int main() {
         test_object();
         test_array();
         test_string();
+        test_string_borrowed();
+        test_string_inline();
         test_string_default();
         test_int();
         test_int_default();
@@ -415,6 +653,9 @@ int main() {
         test_boolean_default();
         test_field_by_name();
         test_get_or_throw();
+        test_object_index();
+        test_clone_shared();
+        test_packed_array();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
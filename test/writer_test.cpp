@@ -0,0 +1,179 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   writer_test.cpp
+ * Author: alex
+ *
+ * Created on October 21, 2026, 3:55 PM
+ */
+
+#include "staticlib/json/writer.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/json/operations.hpp"
+
+const std::string expected_json = R"({
+    "meta": {"count": 3, "tags": ["a", "b"], "empty": {}},
+    "items": [1, "two", {"three": [3.5, null]}, [], {}],
+    "done": true
+})";
+
+bool throws_exc(std::function<void()> fun) {
+    try {
+        fun();
+    } catch (const sl::json::json_exception& e) {
+        (void) e;
+        return true;
+    }
+    return false;
+}
+
+template<typename Sink>
+void write_sample(sl::json::writer<Sink>& wr) {
+    wr.begin_object();
+    wr.key("meta");
+    wr.write(sl::json::loads("{\"count\": 3, \"tags\": [\"a\", \"b\"], \"empty\": {}}"));
+    wr.key("items");
+    wr.begin_array();
+    wr.write(1);
+    wr.write("two");
+    wr.begin_object();
+    wr.key("three");
+    wr.begin_array();
+    wr.write(3.5);
+    wr.write(nullptr);
+    wr.end_array();
+    wr.end_object();
+    wr.begin_array();
+    wr.end_array();
+    wr.begin_object();
+    wr.end_object();
+    wr.end_array();
+    wr.write("done", true);
+    wr.end_object();
+}
+
+void test_layout() {
+    auto expected = sl::json::loads(expected_json);
+    auto variants = std::vector<sl::json::dump_options>();
+    variants.push_back(sl::json::dump_options());
+    variants.push_back(sl::json::dump_options::compact_output());
+    auto single_line = sl::json::dump_options();
+    single_line.indent = 0;
+    variants.push_back(single_line);
+    auto narrow = sl::json::dump_options();
+    narrow.indent = 2;
+    narrow.ensure_ascii = true;
+    variants.push_back(narrow);
+    for (auto& opts : variants) {
+        auto sink = sl::io::string_sink();
+        auto wr = sl::json::make_writer(sink, opts);
+        write_sample(wr);
+        slassert(wr.is_complete());
+        slassert(expected.dumps(opts) == sink.get_string());
+    }
+}
+
+void test_owned_sink() {
+    auto wr = sl::json::make_writer(sl::io::string_sink(), sl::json::dump_options::compact_output());
+    wr.begin_array();
+    for (int i = 0; i < 3; i++) {
+        wr.write(i);
+    }
+    slassert(!wr.is_complete());
+    wr.end_array();
+    slassert(wr.is_complete());
+    slassert("[0,1,2]" == wr.get_sink().get_string());
+}
+
+void test_buffering() {
+    auto sink = sl::io::string_sink();
+    auto wr = sl::json::make_writer(sink, sl::json::dump_options::compact_output());
+    wr.begin_array();
+    wr.write("foo");
+    slassert(sink.get_string().empty());
+    wr.flush();
+    slassert("[\"foo\"" == sink.get_string());
+    // larger than the buffer
+    auto long_str = std::string(10000, 'a');
+    for (int i = 0; i < 3; i++) {
+        wr.write(long_str);
+    }
+    slassert(sink.get_string().size() > long_str.size());
+    wr.begin_object();
+    wr.write(long_str, 42);
+    wr.end_object();
+    wr.end_array();
+    slassert(wr.is_complete());
+    auto res = sl::json::loads(sink.get_string());
+    slassert(5 == res.as_array().size());
+    slassert(long_str == res.as_array()[3].as_string());
+    slassert(42 == res.as_array()[4][long_str].as_int64());
+}
+
+void test_scalar() {
+    auto sink = sl::io::string_sink();
+    auto wr = sl::json::make_writer(sink);
+    wr.write("foo");
+    slassert(wr.is_complete());
+    slassert("\"foo\"" == sink.get_string());
+    slassert(throws_exc([&wr] { wr.write(42); }));
+    slassert(throws_exc([&wr] { wr.begin_array(); }));
+}
+
+void test_errors() {
+    auto sink = sl::io::string_sink();
+    auto wr = sl::json::make_writer(sink);
+    slassert(throws_exc([&wr] { wr.key("foo"); }));
+    slassert(throws_exc([&wr] { wr.end_object(); }));
+    slassert(throws_exc([&wr] { wr.end_array(); }));
+    wr.begin_object();
+    slassert(throws_exc([&wr] { wr.write(42); }));
+    slassert(throws_exc([&wr] { wr.begin_array(); }));
+    slassert(throws_exc([&wr] { wr.end_array(); }));
+    wr.key("foo");
+    slassert(throws_exc([&wr] { wr.key("bar"); }));
+    slassert(throws_exc([&wr] { wr.end_object(); }));
+    wr.begin_array();
+    slassert(throws_exc([&wr] { wr.key("bar"); }));
+    slassert(throws_exc([&wr] { wr.end_object(); }));
+    wr.end_array();
+    wr.end_object();
+    slassert(wr.is_complete());
+    slassert(throws_exc([&wr] { wr.begin_object(); }));
+    slassert("{\n    \"foo\": []\n}" == sink.get_string());
+}
+
+int main() {
+    try {
+        test_layout();
+        test_owned_sink();
+        test_buffering();
+        test_scalar();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}